@@ -42,40 +42,51 @@ SV_INLINE void array_reset(DynamicArray* array)
 	array->size = 0u;
 }
 
+// Grows with memory_reallocate, the big blocks are resized by the OS heap without copies. The new memory is zeroed
+SV_INLINE void __impl__array_grow(DynamicArray* array, u32 capacity, u32 line, const char* file)
+{
+	if (capacity <= array->capacity)
+		return;
+
+	array->data = (u8*)memory_reallocate_ex(array->data, (size_t)capacity * array->stride, line, file);
+	memory_zero(array->data + (size_t)array->capacity * array->stride, (size_t)(capacity - array->capacity) * array->stride);
+	array->capacity = capacity;
+}
+
+// Makes room for count more elements, the capacity grows by the scale factor
+SV_INLINE void __impl__array_ensure(DynamicArray* array, u32 count, u32 line, const char* file)
+{
+	u32 needed = array->size + count;
+
+	if (needed > array->capacity) {
+
+		u32 new_capacity = (u32)((f32)(array->capacity + 1) * array->scale_factor);
+		__impl__array_grow(array, SV_MAX(new_capacity, needed), line, file);
+	}
+}
+
 SV_INLINE void __impl__array_resize(DynamicArray* array, u32 size, u32 line, const char* file)
 {
 	if (size != array->capacity) {
 
-		u8* new_data = (u8*)memory_allocate_ex(size * array->stride, line, file);
+		u8* new_data = (u8*)memory_allocate_ex((size_t)size * array->stride, line, file);
 
-		if (array->size) {
+		if (array->data) {
 			memory_free(array->data);
 		}
 
 		array->data = new_data;
 		array->capacity = size;
 	}
-	else memory_zero(array->data, size * array->stride);
+	else memory_zero(array->data, (size_t)size * array->stride);
 
 	array->size = size;
 }
 
 SV_INLINE void* __impl__array_add(DynamicArray* array, u32 line, const char* file)
 {
-	if (array->size == array->capacity) {
-		
-		u32 new_capacity = (u32)((f32)(array->capacity + 1) * array->scale_factor);
-		
-		u8* new_data = (u8*)memory_allocate_ex(new_capacity * array->stride, line, file);
-
-		if (array->size) {
-			memory_copy(new_data, array->data, array->size * array->stride);
-			memory_free(array->data);
-		}
-
-		array->data = new_data;
-		array->capacity = new_capacity;
-	}
+	if (array->size == array->capacity)
+		__impl__array_ensure(array, 1u, line, file);
 
 	void* res = array->data + (array->size * array->stride);
 	++array->size;
@@ -88,6 +99,36 @@ SV_INLINE void __impl__array_push(DynamicArray* array, const void* data, u32 lin
 	memory_copy(obj, data, array->stride);
 }
 
+// Copies count elements at the end, returns the first one. With data NULL they are left as they are
+SV_INLINE void* __impl__array_push_many(DynamicArray* array, const void* data, u32 count, u32 line, const char* file)
+{
+	__impl__array_ensure(array, count, line, file);
+
+	u8* res = array->data + (size_t)array->size * array->stride;
+	if (data) memory_copy(res, data, (size_t)count * array->stride);
+
+	array->size += count;
+	return res;
+}
+
+// Moves the elements after index to insert count elements, returns the first one. With data NULL they are zeroed
+SV_INLINE void* __impl__array_insert_many(DynamicArray* array, u32 index, const void* data, u32 count, u32 line, const char* file)
+{
+	assert(index <= array->size);
+	__impl__array_ensure(array, count, line, file);
+
+	u8* res = array->data + (size_t)index * array->stride;
+	size_t size = (size_t)count * array->stride;
+
+	memory_move(res + size, res, (size_t)(array->size - index) * array->stride);
+
+	if (data) memory_copy(res, data, size);
+	else memory_zero(res, size);
+
+	array->size += count;
+	return res;
+}
+
 SV_INLINE void array_pop(DynamicArray* array)
 {
 	assert(array->size != 0);
@@ -100,35 +141,29 @@ SV_INLINE void array_pop_count(DynamicArray* array, u32 count)
 	array->size -= count;
 }
 
-SV_INLINE void array_erase(DynamicArray* array, u32 index)
-{
-	assert(index < array->size);
-	--array->size;
-
-	for (u32 i = index; i < array->size; ++i) {
-
-		memory_copy(array->data + (array->stride * i), array->data + (array->stride * (i + 1)), array->stride);
-	}
-}
-
 SV_INLINE void array_erase_range(DynamicArray* array, u32 i0, u32 i1)
 {
 	assert(i0 <= i1);
 	assert(i0 <= array->size && i1 <= array->size);
-	
-	u32 dist = i1 - i0;
-
-	u32 move = array->size - i1;
 
-	for (u32 i = 0; i < move; ++i) {
+	memory_move(array->data + (size_t)i0 * array->stride, array->data + (size_t)i1 * array->stride, (size_t)(array->size - i1) * array->stride);
+	array->size -= i1 - i0;
+}
 
-		u32 dst = i0 + i;
-		u32 src = dst + dist;
+SV_INLINE void array_erase(DynamicArray* array, u32 index)
+{
+	assert(index < array->size);
+	array_erase_range(array, index, index + 1u);
+}
 
-		memory_copy(array->data + (array->stride * dst), array->data + (array->stride * src), array->stride);
-	}
+// Moves the last element to the index, doesn't keep the order
+SV_INLINE void array_swap_remove(DynamicArray* array, u32 index)
+{
+	assert(index < array->size);
+	--array->size;
 
-	array->size -= dist;
+	if (index != array->size)
+		memory_copy(array->data + (size_t)index * array->stride, array->data + (size_t)array->size * array->stride, array->stride);
 }
 
 SV_INLINE void* array_get(DynamicArray* array, u32 index)
@@ -149,6 +184,9 @@ SV_INLINE void* array_last(DynamicArray* array)
 #define array_add(array) __impl__array_add(array, __LINE__, __FILE__)	
 #define array_push(array, obj) __impl__array_push(array, &obj, __LINE__, __FILE__)
 #define array_resize(array, size) __impl__array_resize(array, size, __LINE__, __FILE__)	
+#define array_reserve(array, capacity) __impl__array_grow(array, capacity, __LINE__, __FILE__)
+#define array_push_many(array, data, count) __impl__array_push_many(array, data, count, __LINE__, __FILE__)
+#define array_insert_many(array, index, data, count) __impl__array_insert_many(array, index, data, count, __LINE__, __FILE__)
 
 typedef struct {
 	u8* data;
@@ -260,17 +298,35 @@ SV_INLINE void __impl__buffer_write_back(Buffer* buffer, const void* data, u32 s
 #define buffer_prepare(buffer, capacity) __impl__buffer_capacity(buffer, capacity, __LINE__, __FILE__)
 #define buffer_write_back(buffer, data, size) __impl__buffer_write_back(buffer, data, size, __LINE__, __FILE__)
 
+// INSTANCE ALLOCATOR
+
+// Fixed size instances with stable pointers, create and destroy are O(1).
+// The slots live in pools that are never moved and the free slots are linked in a list.
+// A handle packs the slot index with its generation, it's invalid once the instance is destroyed.
+
+#define INSTANCE_HANDLE_INDEX_BITS 20
+#define INSTANCE_HANDLE_INDEX_MASK ((1u << INSTANCE_HANDLE_INDEX_BITS) - 1u)
+#define INSTANCE_HANDLE_GENERATION_MASK (u32_max >> INSTANCE_HANDLE_INDEX_BITS)
+#define INSTANCE_ALLOCATOR_MAX (INSTANCE_HANDLE_INDEX_MASK + 1u)
+
+typedef u32 InstanceHandle; // 0 is never a valid handle
+
 typedef struct {
-	u8* instances;
-	u32 size;
-	u32 begin_count;
-} InstanceAllocatorPool;
+	u32 index;
+	u32 generation;
+	u32 next_free;
+	u32 alive;
+} InstanceHeader;
 
 typedef struct {
-	InstanceAllocatorPool* pools;
+	u8** pools;
 	u32 pool_count;
+	u32 pool_shift; // The pool size is a power of two
 	u32 instance_size;
-	u32 pool_size;
+	u32 stride; // Header and instance, 16 bytes aligned
+	u32 slot_count; // Slots ever used
+	u32 free_list;
+	u32 size; // Alive instances
 } InstanceAllocator;
 
 SV_INLINE InstanceAllocator instance_allocator_init(u32 instance_size, u32 pool_size)
@@ -278,19 +334,21 @@ SV_INLINE InstanceAllocator instance_allocator_init(u32 instance_size, u32 pool_
 	InstanceAllocator alloc;
 	alloc.pools = NULL;
 	alloc.pool_count = 0u;
-	alloc.instance_size = SV_MAX(instance_size, sizeof(u32));
-	alloc.pool_size = pool_size;
+	alloc.pool_shift = 0u;
+	while ((1u << alloc.pool_shift) < pool_size && alloc.pool_shift < INSTANCE_HANDLE_INDEX_BITS)
+		++alloc.pool_shift;
+	alloc.instance_size = instance_size;
+	alloc.stride = (sizeof(InstanceHeader) + instance_size + 15u) & ~15u;
+	alloc.slot_count = 0u;
+	alloc.free_list = u32_max;
+	alloc.size = 0u;
 	return alloc;
 }
 
 SV_INLINE void instance_allocator_close(InstanceAllocator* alloc)
 {
 	foreach(i, alloc->pool_count) {
-
-		void* ptr = alloc->pools[i].instances;
-		
-		if (ptr != NULL)
-			memory_free(ptr);
+		memory_free(alloc->pools[i]);
 	}
 
 	if (alloc->pools != NULL)
@@ -298,157 +356,117 @@ SV_INLINE void instance_allocator_close(InstanceAllocator* alloc)
 
 	alloc->pools = NULL;
 	alloc->pool_count = 0u;
+	alloc->slot_count = 0u;
+	alloc->free_list = u32_max;
+	alloc->size = 0u;
+}
+
+SV_INLINE InstanceHeader* _instance_allocator_slot(InstanceAllocator* alloc, u32 index)
+{
+	u32 pool_mask = (1u << alloc->pool_shift) - 1u;
+	return (InstanceHeader*)(alloc->pools[index >> alloc->pool_shift] + (index & pool_mask) * alloc->stride);
 }
 
 SV_INLINE void* __impl__instance_allocator_create(InstanceAllocator* alloc, u32 line, const char* file)
 {
-	// Find pool
-	InstanceAllocatorPool* pool = NULL;
+	InstanceHeader* header;
 
-	foreach(i, alloc->pool_count) {
+	if (alloc->free_list != u32_max) {
 
-		if (alloc->pools[i].begin_count != u32_max) {
-			pool = alloc->pools + i;
-			break;
-		}
+		header = _instance_allocator_slot(alloc, alloc->free_list);
+		alloc->free_list = header->next_free;
 	}
+	else {
 
-	if (pool == NULL) {
-		foreach(i, alloc->pool_count) {
-			
-			if (alloc->pools[i].size < alloc->pool_size) {
-				pool = alloc->pools + i;
-				break;
-			}
+		u32 index = alloc->slot_count;
+
+		if (index >= INSTANCE_ALLOCATOR_MAX) {
+			assert_title(FALSE, "Instance allocator limit exceeded");
+			return NULL;
 		}
-	}
-	
-	if (pool == NULL) {
 
-		u32 new_pool_count = alloc->pool_count + 4;
-		InstanceAllocatorPool* new_pools = (InstanceAllocatorPool*)memory_allocate_ex(new_pool_count * sizeof(InstanceAllocatorPool), line, file);
-		memory_copy(new_pools, alloc->pools, alloc->pool_count * sizeof(InstanceAllocatorPool));
-		alloc->pools = new_pools;
+		if ((index >> alloc->pool_shift) == alloc->pool_count) {
 
-		pool = alloc->pools + alloc->pool_count;
+			u8** pools = (u8**)memory_allocate_ex((alloc->pool_count + 1u) * sizeof(u8*), line, file);
 
-		for (u32 i = alloc->pool_count; i < new_pool_count; ++i) {
+			if (alloc->pools != NULL) {
+				memory_copy(pools, alloc->pools, alloc->pool_count * sizeof(u8*));
+				memory_free(alloc->pools);
+			}
 
-			alloc->pools[i].instances = NULL;
-			alloc->pools[i].size = 0u;
-			alloc->pools[i].begin_count = u32_max;
+			pools[alloc->pool_count] = (u8*)memory_allocate_ex(alloc->stride << alloc->pool_shift, line, file);
+			alloc->pools = pools;
+			alloc->pool_count++;
 		}
-		
-		alloc->pool_count = new_pool_count;
-	}
 
-	if (pool->instances == NULL)
-		pool->instances = (u8*)memory_allocate_ex(alloc->pool_size * alloc->instance_size, line, file);
+		alloc->slot_count++;
 
-	void* ptr;
-
-	if (pool->begin_count != u32_max) {
-
-		ptr = pool->instances + pool->begin_count * alloc->instance_size;
-		
-		// Change nextCount
-		u32 next = *(u32*)ptr;
-		
-		if (next == u32_max)
-			pool->begin_count = u32_max;
-		else
-			pool->begin_count += next;
-	}
-	else {
-		ptr = pool->instances + pool->size * alloc->instance_size;
-		++pool->size;
+		header = _instance_allocator_slot(alloc, index);
+		header->index = index;
+		header->generation = 1u;
 	}
 
-	memory_zero(ptr, alloc->instance_size);
+	header->alive = TRUE;
+	header->next_free = u32_max;
+	alloc->size++;
 
+	void* ptr = header + 1;
+	memory_zero(ptr, alloc->instance_size);
 	return ptr;
 }
 
-SV_INLINE u32* _instance_allocator_find_last_count(InstanceAllocator* alloc, void* ptr, InstanceAllocatorPool* pool)
+SV_INLINE void instance_allocator_destroy(InstanceAllocator* alloc, void* ptr)
 {
-	u32* next_count;
-
-	if (pool->begin_count == u32_max) return &pool->begin_count;
+	if (ptr == NULL)
+		return;
 
-	u8* next = pool->instances + (pool->begin_count * alloc->instance_size);
-	u8* end = pool->instances + (pool->size * alloc->instance_size);
+	InstanceHeader* header = (InstanceHeader*)ptr - 1;
 
-	if (next >= ptr) next_count = &pool->begin_count;
-	else {
-		u8* last = next;
-
-		while (next != end) {
+	if (!header->alive) {
+		assert_title(FALSE, "Instance destroyed twice");
+		return;
+	}
 
-			u32 next_value = *(u32*)last;
-			if (next_value == u32_max) break;
+	header->alive = FALSE;
 
-			next += next_value * alloc->instance_size;
-			if (next > ptr) break;
+	// The generation 0 is skipped, that keeps the handle 0 invalid
+	header->generation = (header->generation + 1u) & INSTANCE_HANDLE_GENERATION_MASK;
+	if (header->generation == 0u)
+		header->generation = 1u;
 
-			last = next;
-		}
-		next_count = (u32*)last;
-	}
-
-	return next_count;
+	header->next_free = alloc->free_list;
+	alloc->free_list = header->index;
+	alloc->size--;
 }
 
-SV_INLINE void instance_allocator_destroy(InstanceAllocator* alloc, void* ptr_)
+SV_INLINE u32 instance_allocator_size(InstanceAllocator* alloc)
 {
-	u8* ptr = (u8*)ptr_;
-
-	// Find pool
-	InstanceAllocatorPool* pool = NULL;
-
-	foreach(i, alloc->pool_count) {
-
-		InstanceAllocatorPool* p = alloc->pools + i;
-		
-		if (p->instances != NULL && p->instances <= ptr && p->instances + (p->size * alloc->instance_size) > ptr) {
-
-			pool = p;
-			break;
-		}
-	}
-
-	if (pool == NULL)
-		return;
+	return alloc->size;
+}
 
-	// Remove from list
-	if (ptr == pool->instances + (pool->size - 1u) * alloc->instance_size) {
-		--pool->size;
-	}
-	else {
-		// Update next count
-		u32* next_count = _instance_allocator_find_last_count(alloc, ptr, pool);
+SV_INLINE InstanceHandle instance_allocator_handle(InstanceAllocator* alloc, void* ptr)
+{
+	if (ptr == NULL)
+		return 0u;
 
-		u32 distance;
+	InstanceHeader* header = (InstanceHeader*)ptr - 1;
+	return header->index | (header->generation << INSTANCE_HANDLE_INDEX_BITS);
+}
 
-		if (next_count == &pool->begin_count) {
-			distance = (u32)((ptr - pool->instances) / alloc->instance_size);
-		}
-		else distance = (u32)((ptr - (u8*)next_count) / alloc->instance_size);
+// Returns NULL if the instance of the handle was destroyed
+SV_INLINE void* instance_allocator_get(InstanceAllocator* alloc, InstanceHandle handle)
+{
+	u32 index = handle & INSTANCE_HANDLE_INDEX_MASK;
 
-		u32* free_instance = (u32*)ptr;
+	if (handle == 0u || index >= alloc->slot_count)
+		return NULL;
 
-		if (*next_count == u32_max)
-			*free_instance = u32_max;
-		else
-			*free_instance = *next_count - distance;
+	InstanceHeader* header = _instance_allocator_slot(alloc, index);
 
-		*next_count = distance;
-	}
-}
+	if (!header->alive || header->generation != (handle >> INSTANCE_HANDLE_INDEX_BITS))
+		return NULL;
 
-SV_INLINE u32 instance_allocator_size(InstanceAllocator* alloc)
-{
-	// TODO:
-	return 0;
+	return header + 1;
 }
 
 #define instance_allocator_create(alloc) __impl__instance_allocator_create(alloc, __LINE__, __FILE__)
@@ -456,73 +474,35 @@ SV_INLINE u32 instance_allocator_size(InstanceAllocator* alloc)
 typedef struct {
 	InstanceAllocator* allocator;
 	void* ptr;
-	u8* _next;
-	u32 _pool;
+	u32 _index;
 	b8 has_next;
 } InstanceIterator;
 
 SV_INLINE void instance_iterator_next(InstanceIterator* it)
 {
 	InstanceAllocator* alloc = it->allocator;
-	u8* ptr = (u8*)it->ptr;
 
-	it->has_next = TRUE;
+	while (it->_index < alloc->slot_count) {
 
-	if (ptr == NULL) {
-		
-		while (ptr == NULL) {
-
-			if (alloc->pool_count <= it->_pool) {
-				it->has_next = FALSE;
-				return;
-			}
-		
-			InstanceAllocatorPool* pool = alloc->pools + it->_pool;
-
-			if (pool->size) {
-
-				ptr = pool->instances;
+		InstanceHeader* header = _instance_allocator_slot(alloc, it->_index++);
 
-				if (pool->begin_count == u32_max) {
-					it->_next = (u8*)&pool->begin_count;
-				}
-				else {
-					it->_next = pool->instances + pool->begin_count * alloc->instance_size;
-				}
-			}
-			else ++it->_pool;
-		}
-	}
-	else ptr += alloc->instance_size;
-
-	while (ptr == it->_next) {
-		
-		u32* next_count = (u32*)it->_next;
-		if (*next_count == u32_max) {
-			ptr += alloc->instance_size;
-			break;
+		if (header->alive) {
+			it->ptr = header + 1;
+			it->has_next = TRUE;
+			return;
 		}
-		it->_next += *next_count * alloc->instance_size;
-		ptr += alloc->instance_size;
 	}
 
-	InstanceAllocatorPool* pool = alloc->pools + it->_pool;
-	if (ptr == pool->instances + pool->size * alloc->instance_size) {
-
-		it->ptr = NULL;
-		++it->_pool;
-		instance_iterator_next(it);
-	}
-	else it->ptr = ptr;
+	it->ptr = NULL;
+	it->has_next = FALSE;
 }
 
 SV_INLINE InstanceIterator instance_iterator_begin(InstanceAllocator* allocator)
 {
 	InstanceIterator it;
 	it.allocator = allocator;
-	it._pool = 0u;
 	it.ptr = NULL;
-	it._next = NULL;
+	it._index = 0u;
 
 	instance_iterator_next(&it);
 	
@@ -541,7 +521,7 @@ typedef struct {
 SV_INLINE DynamicString __impl__dynamic_string_init(const char* init_string, f32 scale_factor, u32 line, const char* file)
 {
 	DynamicString str;
-	str.scale_factor = SV_MIN(scale_factor, 1.f);
+	str.scale_factor = SV_MAX(scale_factor, 1.f);
 
 	init_string = string_validate(init_string);
 
@@ -565,50 +545,46 @@ SV_INLINE DynamicString __impl__dynamic_string_init(const char* init_string, f32
 
 SV_INLINE void dynamic_string_close(DynamicString* str)
 {
-	if (str->size) {
+	if (str->capacity) {
 		memory_free(str->data);
 	}
 }
 
-SV_INLINE void __impl__dynamic_string_append(DynamicString* str, const char* src, u32 line, const char* file)
+// The empty string points to a literal until the first allocation
+SV_INLINE void __impl__dynamic_string_reserve(DynamicString* str, u32 capacity, u32 line, const char* file)
 {
-	u32 size = string_size(src);
+	if (capacity <= str->capacity)
+		return;
 
-	if (str->size + size > str->capacity) {
+	str->data = (char*)memory_reallocate_ex(str->capacity ? str->data : NULL, (size_t)capacity + 1, line, file);
+	if (str->capacity == 0u) str->data[0] = '\0';
 
-		u32 new_capacity = (u32)((f32)(str->size + size) * str->scale_factor);
-		char* new_data = (char*)memory_allocate_ex(new_capacity + 1, line, file);
+	str->capacity = capacity;
+}
 
-		if (str->size) {
-			memory_copy(new_data, str->data, str->size);
-			memory_free(str->data);
-		}
+SV_INLINE void __impl__dynamic_string_append(DynamicString* str, const char* src, u32 line, const char* file)
+{
+	u32 size = string_size(src);
+	u32 needed = str->size + size;
 
-		str->data = new_data;
-		str->capacity = new_capacity;
+	if (needed > str->capacity) {
+
+		u32 new_capacity = (u32)((f32)needed * str->scale_factor);
+		__impl__dynamic_string_reserve(str, SV_MAX(new_capacity, needed), line, file);
 	}
 
-	memory_copy(str->data + str->size, src, size);
-	str->size += size;
+	memory_copy(str->data + str->size, src, size + 1);
+	str->size = needed;
 }
 
 SV_INLINE void __impl__dynamic_string_resize(DynamicString* str, u32 size, u32 line, const char* file)
 {
 	if (str->size < size) {
 
-		if (size > str->capacity) {
-
-			u8* new_data = (u8*)memory_allocate_ex(size + 1, line, file);
-			str->capacity = size;
-
-			if (str->size) {
-				memory_copy(new_data, str->data, str->size);
-				memory_free(str->data);
-			}
-
-			str->data = (char*)new_data;
-		}
+		if (size > str->capacity)
+			__impl__dynamic_string_reserve(str, size, line, file);
 
+		memory_zero(str->data + str->size, size - str->size + 1);
 		str->size = size;
 	}
 	else if (str->size > size) {
@@ -620,10 +596,567 @@ SV_INLINE void __impl__dynamic_string_resize(DynamicString* str, u32 size, u32 l
 #define dynamic_string_init(init_string, scale_factor) __impl__dynamic_string_init(init_string, scale_factor, __LINE__, __FILE__)
 #define dynamic_string_append(str, src) __impl__dynamic_string_append(str, src, __LINE__, __FILE__)
 #define dynamic_string_resize(str, size) __impl__dynamic_string_resize(str, size, __LINE__, __FILE__)
+#define dynamic_string_reserve(str, capacity) __impl__dynamic_string_reserve(str, capacity, __LINE__, __FILE__)
+
+// HASH MAP
+
+// Open addressing with robin hood probing, the keys are 64 bit hashes and 0 is reserved for the empty slots.
+// The erase shifts back the next entries, there are no tombstones.
+// The values are moved when the map grows or erases, don't keep pointers to them
+
+#define HASHMAP_MIN_CAPACITY 16
+
+typedef struct {
+	u64* hashes;
+	u8* values;
+	u32 count;
+	u32 capacity; // Power of two
+	u32 stride;
+} HashMap;
 
 typedef struct {
-	u32 todo;
-} HashTable;
+	u32 index;
+	u64 hash;
+	void* value;
+} HashMapIterator;
+
+SV_INLINE HashMap __impl__hashmap_init(u32 stride)
+{
+	HashMap map;
+	map.hashes = NULL;
+	map.values = NULL;
+	map.count = 0u;
+	map.capacity = 0u;
+	map.stride = stride;
+	return map;
+}
+
+SV_INLINE void hashmap_close(HashMap* map)
+{
+	if (map->hashes) {
+		memory_free(map->hashes);
+	}
+
+	map->hashes = NULL;
+	map->values = NULL;
+	map->count = 0u;
+	map->capacity = 0u;
+}
+
+SV_INLINE void hashmap_reset(HashMap* map)
+{
+	if (map->hashes) {
+		memory_zero(map->hashes, map->capacity * sizeof(u64));
+	}
+	map->count = 0u;
+}
+
+// Fibonacci hashing, the user hashes are not always well distributed in the low bits
+SV_INLINE u32 _hashmap_home(HashMap* map, u64 hash)
+{
+	return (u32)((hash * 0x9E3779B97F4A7C15ULL) >> 32) & (map->capacity - 1u);
+}
+
+SV_INLINE u32 _hashmap_distance(HashMap* map, u64 hash, u32 index)
+{
+	return (index - _hashmap_home(map, hash)) & (map->capacity - 1u);
+}
+
+SV_INLINE u32 _hashmap_find(HashMap* map, u64 hash)
+{
+	if (hash == 0 || map->count == 0)
+		return u32_max;
+
+	u32 mask = map->capacity - 1u;
+	u32 index = _hashmap_home(map, hash);
+	u32 distance = 0u;
+
+	while (1) {
+
+		u64 slot = map->hashes[index];
+
+		if (slot == hash)
+			return index;
+
+		// Any entry of the key would be placed before a closer entry
+		if (slot == 0 || _hashmap_distance(map, slot, index) < distance)
+			return u32_max;
+
+		index = (index + 1u) & mask;
+		++distance;
+	}
+}
+
+// Places a new key without checking duplicates, the entries after it are shifted to the next empty slot
+SV_INLINE u32 _hashmap_place(HashMap* map, u64 hash)
+{
+	u32 mask = map->capacity - 1u;
+	u32 index = _hashmap_home(map, hash);
+	u32 distance = 0u;
+
+	while (map->hashes[index] != 0 && _hashmap_distance(map, map->hashes[index], index) >= distance) {
+		index = (index + 1u) & mask;
+		++distance;
+	}
+
+	if (map->hashes[index] != 0) {
+
+		u32 empty = index;
+		while (map->hashes[empty] != 0)
+			empty = (empty + 1u) & mask;
+
+		while (empty != index) {
+
+			u32 prev = (empty - 1u) & mask;
+			map->hashes[empty] = map->hashes[prev];
+			memory_copy(map->values + (empty * map->stride), map->values + (prev * map->stride), map->stride);
+			empty = prev;
+		}
+	}
+
+	map->hashes[index] = hash;
+	++map->count;
+	return index;
+}
+
+SV_INLINE void __impl__hashmap_grow(HashMap* map, u32 capacity, u32 line, const char* file)
+{
+	u64* old_hashes = map->hashes;
+	u8* old_values = map->values;
+	u32 old_capacity = map->capacity;
+
+	u8* data = (u8*)memory_allocate_ex(capacity * (sizeof(u64) + map->stride), line, file);
+	map->hashes = (u64*)data;
+	map->values = data + capacity * sizeof(u64);
+	map->capacity = capacity;
+	map->count = 0u;
+
+	foreach(i, old_capacity) {
+
+		if (old_hashes[i] != 0) {
+			u32 index = _hashmap_place(map, old_hashes[i]);
+			memory_copy(map->values + (index * map->stride), old_values + (i * map->stride), map->stride);
+		}
+	}
+
+	if (old_hashes) {
+		memory_free(old_hashes);
+	}
+}
+
+SV_INLINE void* hashmap_get(HashMap* map, u64 hash)
+{
+	u32 index = _hashmap_find(map, hash);
+	return (index == u32_max) ? NULL : (map->values + (index * map->stride));
+}
+
+// Returns the value of the key, creating it zeroed if it doesn't exist. Returns NULL with the hash 0
+SV_INLINE void* __impl__hashmap_insert(HashMap* map, u64 hash, b8* out_created, u32 line, const char* file)
+{
+	if (out_created != NULL)
+		*out_created = FALSE;
+
+	if (hash == 0)
+		return NULL;
+
+	u32 index = _hashmap_find(map, hash);
+
+	if (index == u32_max) {
+
+		// Max load factor of 7/8
+		if ((map->count + 1u) * 8u > map->capacity * 7u) {
+			u32 capacity = (map->capacity == 0u) ? HASHMAP_MIN_CAPACITY : (map->capacity * 2u);
+			__impl__hashmap_grow(map, capacity, line, file);
+		}
+
+		index = _hashmap_place(map, hash);
+		memory_zero(map->values + (index * map->stride), map->stride);
+
+		if (out_created != NULL)
+			*out_created = TRUE;
+	}
+
+	return map->values + (index * map->stride);
+}
+
+SV_INLINE b8 hashmap_erase(HashMap* map, u64 hash)
+{
+	u32 index = _hashmap_find(map, hash);
+
+	if (index == u32_max)
+		return FALSE;
+
+	u32 mask = map->capacity - 1u;
+	u32 next = (index + 1u) & mask;
+
+	// Backward shift until an empty slot or an entry in its home
+	while (map->hashes[next] != 0 && _hashmap_distance(map, map->hashes[next], next) != 0) {
+
+		map->hashes[index] = map->hashes[next];
+		memory_copy(map->values + (index * map->stride), map->values + (next * map->stride), map->stride);
+
+		index = next;
+		next = (next + 1u) & mask;
+	}
+
+	map->hashes[index] = 0;
+	--map->count;
+	return TRUE;
+}
+
+// Start with a zeroed iterator
+SV_INLINE b8 hashmap_iterator_next(HashMap* map, HashMapIterator* it)
+{
+	u32 index = (it->value == NULL) ? 0u : (it->index + 1u);
+
+	for (; index < map->capacity; ++index) {
+
+		if (map->hashes[index] != 0) {
+			it->index = index;
+			it->hash = map->hashes[index];
+			it->value = map->values + (index * map->stride);
+			return TRUE;
+		}
+	}
+
+	it->index = map->capacity;
+	it->hash = 0;
+	it->value = NULL;
+	return FALSE;
+}
+
+#define HashMap(type) HashMap
+
+#define hashmap_init(T) __impl__hashmap_init(sizeof(T))
+#define hashmap_insert(map, hash, created) __impl__hashmap_insert(map, hash, created, __LINE__, __FILE__)
+
+// SLOT MAP
+
+// The values are packed in a dense array, the iteration only visits the live ones.
+// The handles index a slot table with generations, they are stable until the value is removed.
+// The remove moves the last value to the hole and the arrays are reallocated when they grow, don't keep pointers to the values
+
+#define SLOTMAP_MIN_CAPACITY 16
+
+typedef u32 SlotHandle; // Same layout as InstanceHandle, 0 is never a valid handle
+
+typedef struct {
+	u32 dense; // Index of the value, or the next free slot
+	u32 generation;
+} SlotMapSlot;
+
+typedef struct {
+	u8* values;
+	u32* value_slots; // Slot of each value
+	SlotMapSlot* slots;
+	u32 count;
+	u32 capacity;
+	u32 slot_count; // Slots ever used
+	u32 slot_capacity;
+	u32 free_list;
+	u32 stride;
+} SlotMap;
+
+SV_INLINE SlotMap __impl__slotmap_init(u32 stride)
+{
+	SlotMap map;
+	map.values = NULL;
+	map.value_slots = NULL;
+	map.slots = NULL;
+	map.count = 0u;
+	map.capacity = 0u;
+	map.slot_count = 0u;
+	map.slot_capacity = 0u;
+	map.free_list = u32_max;
+	map.stride = stride;
+	return map;
+}
+
+SV_INLINE void slotmap_close(SlotMap* map)
+{
+	if (map->values) memory_free(map->values);
+	if (map->value_slots) memory_free(map->value_slots);
+	if (map->slots) memory_free(map->slots);
+
+	*map = __impl__slotmap_init(map->stride);
+}
+
+SV_INLINE SlotMapSlot* _slotmap_find(SlotMap* map, SlotHandle handle)
+{
+	u32 index = handle & INSTANCE_HANDLE_INDEX_MASK;
+
+	if (handle == 0u || index >= map->slot_count)
+		return NULL;
+
+	SlotMapSlot* slot = map->slots + index;
+
+	// The free slots are not referenced by any value
+	if (slot->generation != (handle >> INSTANCE_HANDLE_INDEX_BITS) || slot->dense >= map->count || map->value_slots[slot->dense] != index)
+		return NULL;
+
+	return slot;
+}
+
+SV_INLINE void _slotmap_free_slot(SlotMap* map, u32 index)
+{
+	SlotMapSlot* slot = map->slots + index;
+
+	// The generation 0 is skipped, that keeps the handle 0 invalid
+	slot->generation = (slot->generation + 1u) & INSTANCE_HANDLE_GENERATION_MASK;
+	if (slot->generation == 0u)
+		slot->generation = 1u;
+
+	slot->dense = map->free_list;
+	map->free_list = index;
+}
+
+// Returns the new value zeroed, NULL if the limit is exceeded
+SV_INLINE void* __impl__slotmap_insert(SlotMap* map, SlotHandle* out_handle, u32 line, const char* file)
+{
+	u32 index;
+
+	if (map->free_list != u32_max) {
+
+		index = map->free_list;
+		map->free_list = map->slots[index].dense;
+	}
+	else {
+
+		index = map->slot_count;
+
+		if (index >= INSTANCE_ALLOCATOR_MAX) {
+			assert_title(FALSE, "Slot map limit exceeded");
+			if (out_handle) *out_handle = 0u;
+			return NULL;
+		}
+
+		if (index == map->slot_capacity) {
+			map->slot_capacity = (map->slot_capacity == 0u) ? SLOTMAP_MIN_CAPACITY : (map->slot_capacity * 2u);
+			map->slots = (SlotMapSlot*)memory_reallocate_ex(map->slots, (size_t)map->slot_capacity * sizeof(SlotMapSlot), line, file);
+		}
+
+		map->slot_count++;
+		map->slots[index].generation = 1u;
+	}
+
+	if (map->count == map->capacity) {
+		map->capacity = (map->capacity == 0u) ? SLOTMAP_MIN_CAPACITY : (map->capacity * 2u);
+		map->values = (u8*)memory_reallocate_ex(map->values, (size_t)map->capacity * map->stride, line, file);
+		map->value_slots = (u32*)memory_reallocate_ex(map->value_slots, (size_t)map->capacity * sizeof(u32), line, file);
+	}
+
+	u32 dense = map->count++;
+	map->slots[index].dense = dense;
+	map->value_slots[dense] = index;
+
+	if (out_handle) *out_handle = index | (map->slots[index].generation << INSTANCE_HANDLE_INDEX_BITS);
+
+	void* value = map->values + (size_t)dense * map->stride;
+	memory_zero(value, map->stride);
+	return value;
+}
+
+// Returns NULL if the value of the handle was removed
+SV_INLINE void* slotmap_get(SlotMap* map, SlotHandle handle)
+{
+	SlotMapSlot* slot = _slotmap_find(map, handle);
+	return slot ? (map->values + (size_t)slot->dense * map->stride) : NULL;
+}
+
+SV_INLINE b8 slotmap_remove(SlotMap* map, SlotHandle handle)
+{
+	SlotMapSlot* slot = _slotmap_find(map, handle);
+
+	if (slot == NULL)
+		return FALSE;
+
+	u32 dense = slot->dense;
+	u32 last = --map->count;
+
+	if (dense != last) {
+		memory_copy(map->values + (size_t)dense * map->stride, map->values + (size_t)last * map->stride, map->stride);
+		map->value_slots[dense] = map->value_slots[last];
+		map->slots[map->value_slots[dense]].dense = dense;
+	}
+
+	_slotmap_free_slot(map, handle & INSTANCE_HANDLE_INDEX_MASK);
+	return TRUE;
+}
+
+// Removes all the values, their handles become invalid
+SV_INLINE void slotmap_reset(SlotMap* map)
+{
+	foreach(i, map->count) {
+		_slotmap_free_slot(map, map->value_slots[i]);
+	}
+	map->count = 0u;
+}
+
+SV_INLINE u32 slotmap_size(SlotMap* map)
+{
+	return map->count;
+}
+
+// Dense access, the values in [0, size) are the live ones
+SV_INLINE void* slotmap_value(SlotMap* map, u32 index)
+{
+	assert(index < map->count);
+	return map->values + (size_t)index * map->stride;
+}
+
+SV_INLINE SlotHandle slotmap_handle(SlotMap* map, u32 index)
+{
+	assert(index < map->count);
+	u32 slot = map->value_slots[index];
+	return slot | (map->slots[slot].generation << INSTANCE_HANDLE_INDEX_BITS);
+}
+
+#define SlotMap(type) SlotMap
+
+#define slotmap_init(T) __impl__slotmap_init(sizeof(T))
+#define slotmap_insert(map, handle) __impl__slotmap_insert(map, handle, __LINE__, __FILE__)
+
+// LINEAR ALLOCATOR
+
+// Allocations are a pointer bump, they are freed all at once with a rewind.
+// The memory is a chain of blocks, the pointers are stable and the blocks are reused after a rewind
+
+#define LINEAR_ALLOCATOR_ALIGNMENT 16
+
+typedef struct LinearAllocatorBlock {
+	struct LinearAllocatorBlock* next;
+	u64 capacity;
+} LinearAllocatorBlock;
+
+typedef struct {
+	LinearAllocatorBlock* first;
+	LinearAllocatorBlock* current;
+	u64 offset; // Used bytes of the current block
+	u64 block_size;
+} LinearAllocator;
+
+typedef struct {
+	LinearAllocatorBlock* block;
+	u64 offset;
+} LinearAllocatorMark;
+
+SV_INLINE LinearAllocator linear_allocator_init(u64 block_size)
+{
+	LinearAllocator alloc;
+	alloc.first = NULL;
+	alloc.current = NULL;
+	alloc.offset = 0u;
+	alloc.block_size = SV_MAX(block_size, 1024u);
+	return alloc;
+}
+
+SV_INLINE void linear_allocator_close(LinearAllocator* alloc)
+{
+	LinearAllocatorBlock* block = alloc->first;
+
+	while (block) {
+		LinearAllocatorBlock* next = block->next;
+		memory_free(block);
+		block = next;
+	}
+
+	alloc->first = NULL;
+	alloc->current = NULL;
+	alloc->offset = 0u;
+}
+
+SV_INLINE u64 _linear_allocator_align(LinearAllocatorBlock* block, u64 offset, u64 alignment)
+{
+	u64 address = (u64)(size_t)(block + 1) + offset;
+	return offset + (((address + alignment - 1u) & ~(alignment - 1u)) - address);
+}
+
+// Moves to the next block, reusing it if it's large enough
+SV_INLINE void* __impl__linear_allocator_grow(LinearAllocator* alloc, u64 size, u64 alignment, u32 line, const char* file)
+{
+	LinearAllocatorBlock* next = alloc->current ? alloc->current->next : alloc->first;
+
+	if (next == NULL || _linear_allocator_align(next, 0u, alignment) + size > next->capacity) {
+
+		u64 capacity = SV_MAX(alloc->block_size, size + alignment);
+		LinearAllocatorBlock* block = (LinearAllocatorBlock*)memory_allocate_ex(sizeof(LinearAllocatorBlock) + capacity, line, file);
+		block->capacity = capacity;
+		block->next = next;
+
+		if (alloc->current) alloc->current->next = block;
+		else alloc->first = block;
+
+		next = block;
+	}
+
+	u64 begin = _linear_allocator_align(next, 0u, alignment);
+
+	alloc->current = next;
+	alloc->offset = begin + size;
+
+	return (u8*)(next + 1) + begin;
+}
+
+// Alignment must be power of two. The memory is not initialized
+SV_INLINE void* __impl__linear_allocator_push_uninit(LinearAllocator* alloc, u64 size, u64 alignment, u32 line, const char* file)
+{
+	LinearAllocatorBlock* block = alloc->current;
+
+	if (block) {
+
+		u64 begin = _linear_allocator_align(block, alloc->offset, alignment);
+
+		if (begin + size <= block->capacity) {
+			alloc->offset = begin + size;
+			return (u8*)(block + 1) + begin;
+		}
+	}
+
+	return __impl__linear_allocator_grow(alloc, size, alignment, line, file);
+}
+
+SV_INLINE void* __impl__linear_allocator_push(LinearAllocator* alloc, u64 size, u64 alignment, u32 line, const char* file)
+{
+	void* ptr = __impl__linear_allocator_push_uninit(alloc, size, alignment, line, file);
+	memory_zero(ptr, size);
+	return ptr;
+}
+
+SV_INLINE LinearAllocatorMark linear_allocator_mark(LinearAllocator* alloc)
+{
+	LinearAllocatorMark mark;
+	mark.block = alloc->current;
+	mark.offset = alloc->offset;
+	return mark;
+}
+
+// Frees everything allocated after the mark
+SV_INLINE void linear_allocator_rewind(LinearAllocator* alloc, LinearAllocatorMark mark)
+{
+	alloc->current = mark.block;
+	alloc->offset = mark.offset;
+}
+
+SV_INLINE void linear_allocator_reset(LinearAllocator* alloc)
+{
+	alloc->current = NULL;
+	alloc->offset = 0u;
+}
+
+#define linear_allocator_push(alloc, size) __impl__linear_allocator_push(alloc, size, LINEAR_ALLOCATOR_ALIGNMENT, __LINE__, __FILE__)
+#define linear_allocator_push_uninit(alloc, size) __impl__linear_allocator_push_uninit(alloc, size, LINEAR_ALLOCATOR_ALIGNMENT, __LINE__, __FILE__)
+#define linear_allocator_push_aligned(alloc, size, alignment) __impl__linear_allocator_push(alloc, size, alignment, __LINE__, __FILE__)
+#define linear_allocator_push_array(alloc, T, count) ((T*)__impl__linear_allocator_push(alloc, sizeof(T) * (count), LINEAR_ALLOCATOR_ALIGNMENT, __LINE__, __FILE__))
+
+// FRAME ALLOCATOR
+
+// Memory valid until the end of the next frame, hosebase_frame_begin swaps and resets the two allocators.
+// Only for the main thread
+void* frame_allocate(u64 size);
+LinearAllocator* frame_allocator();
+
+void _frame_allocator_swap();
+void _frame_allocator_close();
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,180 @@
+// String scanning benchmark, compares the vectorized helpers of memory_manager.c with the scalar loops they replaced.
+// Built by hand, from the folder that contains the Hosebase folder:
+//
+//   gcc -O2 -fgnu89-inline -DSV_PLATFORM_LINUX=1 -I. Hosebase/bench/string_scan.c Hosebase/src/memory_manager.c -lm -o string_scan
+//
+// Add -mavx2 for the AVX2 paths, or -mno-sse2 on x86 32 bits for the scalar fallback. Prints the seconds of each pass
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "Hosebase/platform.h"
+#include "Hosebase/memory_manager.h"
+
+#define BENCH_SIZE (1u << 24)
+#define BENCH_PASSES 10
+
+// The memory manager locks its allocators, the benchmark has one thread
+void fast_mutex_lock(FastMutex *mutex) {}
+void fast_mutex_unlock(FastMutex *mutex) {}
+
+///////////////////////////// SCALAR ////////////////////////////
+
+static u32 scalar_length(const char *str)
+{
+	const char *it = str;
+
+	while (*it != '\0')
+		++it;
+
+	return (u32)(it - str);
+}
+
+static u32 scalar_mismatch(const char *s0, const char *s1)
+{
+	u32 i = 0;
+
+	while (s0[i] == s1[i] && s0[i] != '\0')
+		++i;
+
+	return i;
+}
+
+static const char *scalar_find_any(const char *str, const char *set, u32 set_count)
+{
+	while (*str != '\0')
+	{
+		foreach (i, set_count)
+		{
+			if (set[i] == *str)
+				return str;
+		}
+
+		++str;
+	}
+
+	return str;
+}
+
+static const char *scalar_skip_whitespace(const char *str)
+{
+	while (*str == ' ' || *str == '\t' || *str == '\r' || *str == '\n')
+		++str;
+
+	return str;
+}
+
+///////////////////////////// BENCH ////////////////////////////
+
+static f64 bench_now()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (f64)t.tv_sec + (f64)t.tv_nsec * 1e-9;
+}
+
+static volatile u64 bench_sink;
+
+static void bench_print(const char *name, f64 vector_time, f64 scalar_time)
+{
+	printf("%-16s vector %.3f s  scalar %.3f s  x%.1f\n", name, vector_time, scalar_time, scalar_time / vector_time);
+}
+
+int main()
+{
+	// Text without the searched characters, the scans run through the whole buffer
+	char *text = malloc(BENCH_SIZE + 1);
+	char *copy = malloc(BENCH_SIZE + 1);
+	char *blank = malloc(BENCH_SIZE + 1);
+
+	foreach (i, BENCH_SIZE)
+	{
+		text[i] = 'a' + (char)(i % 20);
+		blank[i] = " \t\r\n"[i % 4];
+	}
+
+	text[BENCH_SIZE] = '\0';
+	blank[BENCH_SIZE] = '\0';
+	memory_copy(copy, text, BENCH_SIZE + 1);
+
+	b8 valid = string_length(text) == scalar_length(text) &&
+			   string_mismatch(text, copy) == scalar_mismatch(text, copy) &&
+			   string_find_any(text, "<>/", 3) == scalar_find_any(text, "<>/", 3) &&
+			   string_skip_whitespace(blank) == scalar_skip_whitespace(blank);
+
+	if (!valid)
+	{
+		printf("The vector and scalar results differ\n");
+		return 1;
+	}
+
+	f64 t0, t1;
+
+	t0 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += string_length(text);
+	t0 = bench_now() - t0;
+
+	t1 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += scalar_length(text);
+	t1 = bench_now() - t1;
+
+	bench_print("length", t0, t1);
+
+	t0 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += string_mismatch(text, copy);
+	t0 = bench_now() - t0;
+
+	t1 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += scalar_mismatch(text, copy);
+	t1 = bench_now() - t1;
+
+	bench_print("compare", t0, t1);
+
+	t0 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += (u64)(string_find_char(text, '<') - text);
+	t0 = bench_now() - t0;
+
+	t1 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += (u64)(scalar_find_any(text, "<", 1) - text);
+	t1 = bench_now() - t1;
+
+	bench_print("find char", t0, t1);
+
+	t0 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += (u64)(string_find_any(text, "<>/=\"", 5) - text);
+	t0 = bench_now() - t0;
+
+	t1 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += (u64)(scalar_find_any(text, "<>/=\"", 5) - text);
+	t1 = bench_now() - t1;
+
+	bench_print("find any", t0, t1);
+
+	t0 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += (u64)(string_skip_whitespace(blank) - blank);
+	t0 = bench_now() - t0;
+
+	t1 = bench_now();
+	foreach (i, BENCH_PASSES)
+		bench_sink += (u64)(scalar_skip_whitespace(blank) - blank);
+	t1 = bench_now() - t1;
+
+	bench_print("skip whitespace", t0, t1);
+
+	free(text);
+	free(copy);
+	free(blank);
+
+	return 0;
+}
@@ -110,6 +110,12 @@ constexpr f64	f64_max = std::numeric_limits<f64>::max();*/
 
 #define SV_INLINE inline static
 
+#if defined(_MSC_VER)
+#define SV_THREAD_LOCAL __declspec(thread)
+#else
+#define SV_THREAD_LOCAL __thread
+#endif
+
 #if SV_PLATFORM_WINDOWS
 #define SV_IN_PC 1
 #else
@@ -170,6 +176,23 @@ void windows_print(PrintStyle style, const char* str, ...);
 #define SV_LOG_WARNING(x, ...) __android_log_print(ANDROID_LOG_WARN, "native-activity", x, ##__VA_ARGS__)
 #define SV_LOG_ERROR(x, ...) __android_log_print(ANDROID_LOG_ERROR, "native-activity", x, ##__VA_ARGS__)
 
+#elif SV_PLATFORM_LINUX
+
+#define SV_EXPORT __attribute__((visibility("default")))
+
+typedef enum {
+	PrintStyle_Info,
+	PrintStyle_Warning,
+	PrintStyle_Error,
+} PrintStyle;
+
+void linux_print(PrintStyle style, const char* str, ...);
+
+#define SV_LOG_VERBOSE(x, ...) {;}
+#define SV_LOG_INFO(x, ...) linux_print(PrintStyle_Info, x, ##__VA_ARGS__)
+#define SV_LOG_WARNING(x, ...) linux_print(PrintStyle_Warning, x, ##__VA_ARGS__)
+#define SV_LOG_ERROR(x, ...) linux_print(PrintStyle_Error, x, ##__VA_ARGS__)
+
 #endif
 
 #else
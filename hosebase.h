@@ -128,6 +128,12 @@ SV_INLINE void hosebase_close()
 	
 	_asset_close();
 	_event_close();
+
+	_frame_allocator_close();
+
+#if SV_SLOW
+	_memory_profiler_close();
+#endif
 }
 
 
@@ -150,6 +156,8 @@ SV_INLINE b8 hosebase_frame_begin()
 #if SV_SLOW
 	_profiler_reset();
 #endif
+
+	_frame_allocator_swap();
 	
 	_input_update();
 	if (!platform_recive_input()) return FALSE; // Close request
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "Hosebase/defines.h"
+
+#if SV_GRAPHICS
+
 #include "Hosebase/graphics.h"
 #include "Hosebase/math.h"
 #include "Hosebase/font.h"
@@ -77,9 +81,9 @@ struct GuiParent {
 	GuiLayout layout;
 
 	GuiParent* parent;
-	// TODO: Dynamic
-	GuiParent* childs[1000];
+	GuiParent** childs; // Frame allocated, rebuilt in every gui_end
 	u32 child_count;
+	u32 child_capacity;
 
 	struct {
 		GPUImage* image;
@@ -244,4 +248,6 @@ typedef struct {
 
 u32 gui_register_layout(const GuiRegisterLayoutDesc* desc);
 
-SV_END_C_HEADER
\ No newline at end of file
+SV_END_C_HEADER
+
+#endif
\ No newline at end of file
@@ -4,375 +4,138 @@
 
 SV_BEGIN_C_HEADER
 
+// The allocations up to 32KB come from size class slabs with a cache per thread, the rest from the OS heap.
+// memory_allocate returns zeroed memory, memory_allocate_uninit skips it for the buffers that are overwritten anyway.
+// memory_reallocate keeps the content, the new bytes are not initialized
+
 #if SV_SLOW
 
 void* __impl__memory_allocate(size_t size, u32 line, const char* file);
+void* __impl__memory_allocate_uninit(size_t size, u32 line, const char* file);
+void* __impl__memory_reallocate(void* ptr, size_t size, u32 line, const char* file);
 
 #define memory_allocate(size) __impl__memory_allocate(size, __LINE__, __FILE__)
 #define memory_allocate_ex(size, line, file) __impl__memory_allocate(size, line, file)
+#define memory_allocate_uninit(size) __impl__memory_allocate_uninit(size, __LINE__, __FILE__)
+#define memory_allocate_uninit_ex(size, line, file) __impl__memory_allocate_uninit(size, line, file)
+#define memory_reallocate(ptr, size) __impl__memory_reallocate(ptr, size, __LINE__, __FILE__)
+#define memory_reallocate_ex(ptr, size, line, file) __impl__memory_reallocate(ptr, size, line, file)
 
 #else
 
 void* memory_allocate(size_t size);
+void* memory_allocate_uninit(size_t size);
+void* memory_reallocate(void* ptr, size_t size);
 
 #define memory_allocate_ex(size, line, file) memory_allocate(size)
+#define memory_allocate_uninit_ex(size, line, file) memory_allocate_uninit(size)
+#define memory_reallocate_ex(ptr, size, line, file) memory_reallocate(ptr, size)
 
 #endif
 
 void memory_free(void* ptr);
 
-#define memory_copy(dst, src, size) memcpy(dst, src, size)
-#define memory_zero(dst, size) memset(dst, 0, size)
-
-void memory_swap(void* p0, void* p1, size_t size);
-
-SV_INLINE b8 array_prepare(void** data, u32* count, u32* capacity, u32 new_capacity, u32 add, u32 stride)
-{
-	if (*count + add > * capacity) {
-
-		u8* new_data = (u8*)memory_allocate(new_capacity * stride);
-
-		if (*count) {
-			memory_copy(new_data, *data, *count * stride);
-			memory_free(*data);
-		}
-
-		*data = new_data;
-		*capacity = new_capacity;
-		return TRUE;
-	}
-	return FALSE;
-}
-
-typedef struct
-{
-	u64 hash;
-	void *next;
-} HashTableEntry;
-
-SV_INLINE void* hashtable_get(u64 hash, void *_data, u32 stride, u32 table_size, b8 create, b8 *out_created)
-{
-	assert(sizeof(HashTableEntry) <= stride);
+// Gives the cached blocks of the calling thread back to the other threads, called when the threads finish
+void _memory_thread_close();
 
-	if (hash == 0)
-	{
-		if (out_created != NULL)
-			*out_created = FALSE;
-		return NULL;
-	}
-
-	u8 *data = (u8 *)_data;
-	u32 index = hash % table_size;
-
-	HashTableEntry *parent = NULL;
-	HashTableEntry *entry = (HashTableEntry *)(data + (index * stride) + stride - sizeof(HashTableEntry));
-
-	b8 first_entry_empty = entry->hash == 0;
-
-	while ((entry->hash != 0 || entry->next != NULL) && entry->hash != hash)
-	{
-		parent = entry;
-		entry = (HashTableEntry*)parent->next;
-
-		if (parent->next == NULL)
-			break;
-		
-		entry = (HashTableEntry*)((u8*)entry + stride - sizeof(HashTableEntry));
-	}
-
-	b8 created = FALSE;
-
-	if (entry != NULL && entry->hash == hash)
-	{
-		created = FALSE;
-	}
-	else if (create)
-	{
-		if (first_entry_empty)
-		{
-			entry = (HashTableEntry *)(data + (index * stride) + stride - sizeof(HashTableEntry));
-		}
-
-		created = TRUE;
-
-		if (entry == NULL)
-		{
-			parent->next = memory_allocate(stride);
-			entry = (HashTableEntry*)parent->next;
-			entry = (HashTableEntry*)((u8*)entry + stride - sizeof(HashTableEntry));
-		}
-		
-		entry->hash = hash;
-	}
-
-	if (out_created != NULL)
-		*out_created = created;
-
-	return (entry == NULL || entry->hash == 0) ? NULL : ((u8 *)entry + sizeof(HashTableEntry) - stride);
-}
-
-SV_INLINE b8 hashtable_erase(u64 hash, void *_data, u32 stride, u32 table_size)
-{
-	assert(sizeof(HashTableEntry) <= stride);
-
-	if (hash == 0)
-	{
-		return FALSE;
-	}
+#if SV_SLOW
 
-	u8 *data = (u8 *)_data;
-	u32 index = hash % table_size;
+// HEAP PROFILER
 
-	HashTableEntry *parent = NULL;
-	HashTableEntry *entry = (HashTableEntry *)(data + (index * stride) + stride - sizeof(HashTableEntry));
+// Every allocation is counted in its callsite, or in its callsite and stack when the stack capture is enabled
 
-	while ((entry->hash != 0 || entry->next != NULL) && entry->hash != hash)
-	{
-		parent = entry;
-		entry = (HashTableEntry*)parent->next;
+#define MEMORY_PROFILER_STACK_SIZE 8
 
-		if (parent->next == NULL)
-			return FALSE;
-		
-		entry = (HashTableEntry*)((u8*)entry + stride - sizeof(HashTableEntry));
-	}
-
-	void* entry_data = (u8*)entry + sizeof(HashTableEntry) - stride;
-
-	if (parent == NULL)
-	{
-		void* next = entry->next;
-		memory_zero(entry_data, stride);
-		entry->next = next;
-	}
-	else
-	{
-		parent->next = entry->next;
-		memory_free(entry_data);
-	}
+typedef struct {
+	const char* file;
+	u32 line;
+	u64 live_bytes;
+	u64 live_count;
+	u64 peak_bytes; // Maximum live bytes
+	u64 total_count; // Allocations since the start
+	void* stack[MEMORY_PROFILER_STACK_SIZE];
+} MemoryCallsite;
 
-	return TRUE;
-}
+void memory_profiler_stack_capture(b8 enable);
 
-static void _hashtable_free_entry(u8* entry_data, u32 stride)
-{
-	HashTableEntry *entry = (HashTableEntry *)(entry_data + stride - sizeof(HashTableEntry));
+// Fills the callsites sorted by live bytes, returns the count
+u32 memory_profiler_callsites(MemoryCallsite* callsites, u32 max);
 
-	if (entry->next != NULL)
-	{
-		_hashtable_free_entry((u8*)entry->next, stride);
-	}
+u64 memory_profiler_live_bytes();
+u64 memory_profiler_peak_bytes();
 
-	memory_free(entry->next);
-}
+// Prints the first callsites sorted by live bytes
+void memory_profiler_report(u32 max);
 
-SV_INLINE void hashtable_free(void *_data, u32 stride, u32 table_size)
-{
-	assert(sizeof(HashTableEntry) <= stride);
+// Prints the peak usage and the callsites with allocations still alive
+void _memory_profiler_close();
 
-	u8 *data = (u8 *)_data;
+#endif
 
-	foreach(i, table_size)
-	{
-		HashTableEntry *entry = (HashTableEntry *)(data + (i * stride) + stride - sizeof(HashTableEntry));
-		
-		if (entry->next != NULL)
-		{
-			_hashtable_free_entry((u8*)entry->next, stride);
-		}
-	}
-}
+#define memory_copy(dst, src, size) memcpy(dst, src, size)
+#define memory_move(dst, src, size) memmove(dst, src, size)
+#define memory_zero(dst, size) memset(dst, 0, size)
 
-typedef struct {
-	HashTableEntry* entry;
-	HashTableEntry* parent;
-	HashTableEntry* end;
-	void* value;
-} HashTableIterator;
+void memory_swap(void* p0, void* p1, size_t size);
 
-SV_INLINE b8 hashtable_iterator_next(HashTableIterator* it, void* data, u32 stride, u32 table_size)
+SV_INLINE b8 array_prepare(void** data, u32* count, u32* capacity, u32 new_capacity, u32 add, u32 stride)
 {
-	if (it->entry == NULL) {
-
-		it->entry = (HashTableEntry*)((u8*)data + stride - sizeof(HashTableEntry));
-		it->value = ((u8*)it->entry + sizeof(HashTableEntry) - stride);
-		it->parent = it->entry;
-		it->end = (HashTableEntry*)((u8*)data + (table_size * stride) + stride - sizeof(HashTableEntry));
-
-		if (it->entry->hash != 0)
-			return TRUE;
-	}
-
-	while (1) 
-	{
-		while (it->entry->next != NULL) 
-		{
-			it->entry = (HashTableEntry*)(((u8*)it->entry->next) + stride - sizeof(HashTableEntry));
-
-			if (it->entry->hash != 0) {
-				it->value = ((u8*)it->entry + sizeof(HashTableEntry) - stride);
-				return TRUE;
-			}
-		}
+	if (*count + add > * capacity) {
 
-		it->parent = (HashTableEntry*)((u8*)it->parent + stride);
-		it->entry = it->parent;
+		new_capacity = SV_MAX(new_capacity, *count + add);
 
-		if (it->entry >= it->end)
-		{
-			it->value = NULL;
-			return FALSE;
-		}
+		u8* new_data = (u8*)memory_reallocate(*capacity ? *data : NULL, (size_t)new_capacity * stride);
+		memory_zero(new_data + (size_t)*capacity * stride, (size_t)(new_capacity - *capacity) * stride);
 
-		if (it->entry->hash != 0) {
-			it->value = ((u8*)it->entry + sizeof(HashTableEntry) - stride);
-			return TRUE;
-		}
+		*data = new_data;
+		*capacity = new_capacity;
+		return TRUE;
 	}
-
-	it->value = NULL;
 	return FALSE;
 }
 
 typedef b8(*LessThanFn)(const void*, const void*);
 
-struct _SortData {
-	u8* data;
-	u32 stride;
-	LessThanFn fn;
-};
-
-static void _insertion_sort(struct _SortData* data, u32 begin, u32 end)
-{
-	for (u32 i = begin + 1; i < end; ++i) {
-
-		i32 j = i - 1;
-
-		while (1) {
-
-			if (!data->fn(data->data + (i * data->stride), data->data + (j * data->stride))) {
-				++j;
-				break;
-			}
+// Introsort, the order of the equal elements is not preserved
+void array_sort(void* data, u32 count, u32 stride, void* fn);
 
-			--j;
+// Stable ascending sort by the key at 'key_offset' of each element, O(n). The scratch needs count * stride bytes, it's allocated if NULL.
+// task_parallel_radix_sort_* computes the histograms in parallel
+void array_radix_sort_u32(void* data, u32 count, u32 stride, u32 key_offset, void* scratch);
+void array_radix_sort_u64(void* data, u32 count, u32 stride, u32 key_offset, void* scratch);
+void array_radix_sort_f32(void* data, u32 count, u32 stride, u32 key_offset, void* scratch);
 
-			if (j == begin - 1) {
-				j = begin;
-				break;
-			}
-		}
+// Used by the radix sorts, the histograms are 256 counters per key byte
+void _array_radix_histogram(const void* data, u32 begin, u32 end, u32 stride, u32 key_offset, u32 key_size, b8 float_key, u32* histograms);
+void _array_radix_scatter(void* data, u32 count, u32 stride, u32 key_offset, u32 key_size, b8 float_key, void* scratch, u32* histograms);
 
-		if (j != i) {
-
-			for (u32 w = j; w < i; ++w) {
-
-				memory_swap(data->data + (i * data->stride), data->data + (w * data->stride), data->stride);
-			}
-		}
-	}
-}
-
-static void _quick_sort(struct _SortData* data, u32 left_limit, u32 right_limit)
+SV_INLINE const char* string_validate(const char* str)
 {
-	i32 left = left_limit;
-
-	i32 right = right_limit;
-	u32 pivote = right;
-	--right;
-
-	while (1) {
-
-		while (data->fn(data->data + (left * data->stride), data->data + (pivote * data->stride)) && left < right) ++left;
-		while (data->fn(data->data + (pivote * data->stride), data->data + (right * data->stride)) && right > left) --right;
-
-		if (left < right) {
-
-			memory_swap(data->data + (left * data->stride), data->data + (right * data->stride), data->stride);
-			++left;
-			--right;
-		}
-		else break;
-	}
-
-	if (left < right)
-		++left;
-
-	if (!data->fn(data->data + (left * data->stride), data->data + (pivote * data->stride))) {
-
-		memory_swap(data->data + (left * data->stride), data->data + (right_limit * data->stride), data->stride);
-	}
-
-	if (left_limit != left) {
-
-		if (left - left_limit <= 100) {
-			_insertion_sort(data, left_limit, left + 1);
-		}
-		else _quick_sort(data, left_limit, left);
-	}
-	if (left + 1 != right_limit) {
-
-		if (right_limit - (left + 1) <= 100) {
-			_insertion_sort(data, left + 1, right_limit + 1);
-		}
-		else _quick_sort(data, left + 1, right_limit);
-	}
+	return str ? str : "";
 }
 
-SV_INLINE void array_sort(void* data, u32 count, u32 stride, void* fn)
-{
-	if (data == NULL || count == 0)
-		return;
+// Vectorized scanning, SSE2, AVX2 or NEON when the compiler enables them
 
-	struct _SortData d;
-	d.data = (u8*)data;
-	d.stride = stride;
-	d.fn = (LessThanFn)fn;
+size_t string_length(const char* str);
 
-	if (count > 100 && count < 15000) {
+// Returns the first character of the set or the terminator. The set can't contain '\0'
+const char* string_find_any(const char* str, const char* set, u32 set_count);
+const char* string_find_char(const char* str, char c);
 
-		_quick_sort(&d, 0, count - 1);
-	}
-	else {
-		// TODO: Fastest algorithm for biggest array lengths
-		_insertion_sort(&d, 0, count);
-	}
-}
+// Skips spaces, tabs and line breaks
+const char* string_skip_whitespace(const char* str);
 
-SV_INLINE const char* string_validate(const char* str)
-{
-	return str ? str : "";
-}
+// Returns the index of the first different character or of the terminator if the strings are equal
+u32 string_mismatch(const char* s0, const char* s1);
 
 SV_INLINE u32 string_split(const char* line, char* delimiters, u32 count)
 {
-	const char* it = line;
-	
-	while (*it != '\0') {
-		
-		b8 end = FALSE;
-		
-		foreach(i, count)
-			if (delimiters[i] == *it) {
-				end = TRUE;
-				break;
-			}
-		
-		if (end) break;
-	    
-		++it;
-	}
-	
-	u32 size = it - line;
-	
-	return size;
+	return (u32)(string_find_any(line, delimiters, count) - line);
 }
 
 SV_INLINE u32 string_size(const char* str)
 {
-	u32 size = 0u;
-	while (*str++) ++size;
-	return size;
+	return (u32)string_length(str);
 }
 
 SV_INLINE b8 string_empty(const char* str)
@@ -382,28 +145,13 @@ SV_INLINE b8 string_empty(const char* str)
 
 SV_INLINE b8 string_begins(const char* s0, const char* s1)
 {
-	while (*s0 && *s1) {
-		if (*s0 != *s1)
-			return FALSE;
-		
-		++s0;
-		++s1;
-	}
-	
-	return *s0 == *s1 || *s1 == '\0';
+	return s1[string_mismatch(s0, s1)] == '\0';
 }
 
 SV_INLINE b8 string_equals(const char* s0, const char* s1)
 {
-	while (*s0 && *s1) {
-		if (*s0 != *s1)
-			return FALSE;
-		
-		++s0;
-		++s1;
-	}
-	
-	return *s0 == *s1;
+	u32 i = string_mismatch(s0, s1);
+	return s0[i] == s1[i];
 }
 
 SV_INLINE u32 string_append(char* dst, const char* src, u32 buff_size)
@@ -511,261 +259,23 @@ SV_INLINE void string_replace_char(char* dst, char old_char, char new_char)
 	}
 }
 
-SV_INLINE void string_from_u32(char* dst, u32 value)
-{
-	u32 digits = 0u;
-
-	u32 aux = value;
-	while (aux != 0) {
-		aux /= 10;
-		++digits;
-	}
-
-	if (digits == 0u) {
-		string_copy(dst, "0", 11);
-		return;
-	}
-
-	i32 end = (i32)digits - 1;
-	
-	for (i32 i = end; i >= 0; --i) {
-
-		u32 v = value % 10;
-
-		switch (v) {
-
-		case 0:
-			dst[i] = '0';
-			break;
-
-		case 1:
-			dst[i] = '1';
-			break;
-
-		case 2:
-			dst[i] = '2';
-			break;
-
-		case 3:
-			dst[i] = '3';
-			break;
-
-		case 4:
-			dst[i] = '4';
-			break;
-
-		case 5:
-			dst[i] = '5';
-			break;
-			
-		case 6:
-			dst[i] = '6';
-			break;
-
-		case 7:
-			dst[i] = '7';
-			break;
-
-		case 8:
-			dst[i] = '8';
-			break;
-
-		case 9:
-			dst[i] = '9';
-			break;
-			
-		}
-		
-		value /= 10;
-	}
-
-	dst[end + 1] = '\0';
-}
-
-SV_INLINE void string_from_f32(char* dst, f32 value, u32 decimals)
-{
-	i32 decimal_mult = 0;
+// Number conversion, exact and without locale. The parsers return the end of the number and don't skip spaces
 
-	if (decimals > 0)
-	{
-		u32 d = decimals;
-
-		decimal_mult = 10;
-		d--;
-
-		while (d--)
-		{
-			decimal_mult *= 10;
-		}
-	}
-
-	b8 minus = value < 0.f;
-	value = SV_ABS(value);
-
-	i32 integer = (i32)value;
-	i32 decimal = (value - (f32)integer) * (f32)decimal_mult;
-
-	if (minus)
-	{
-		string_copy(dst, "-", 50);
-	}
-	else
-	{
-		string_copy(dst, "", 50);
-	}
-
-	char integer_string[20];
-	string_from_u32(integer_string, integer);
-
-	string_append(dst, integer_string, 50);
-
-	string_append(dst, ".", 50);
-
-	string_from_u32(integer_string, decimal);
-
-	u32 decimal_size = string_size(integer_string);
-	while (decimal_size < decimals)
-	{
-		string_append(integer_string, "0", 20);
-		decimal_size++;
-	}
-
-	string_append(dst, integer_string, 50);
-}
-
-SV_INLINE void string_from_u64(char* dst, u64 value)
-{
-	u32 digits = 0u;
-
-	u64 aux = value;
-	while (aux != 0) {
-		aux /= 10;
-		++digits;
-	}
-
-	if (digits == 0u) {
-		string_copy(dst, "0", 20);
-		return;
-	}
-
-	i32 end = (i32)digits - 1;
-
-	for (i32 i = end; i >= 0; --i) {
-
-		u64 v = value % 10;
-
-		switch (v) {
-
-		case 0:
-			dst[i] = '0';
-			break;
-
-		case 1:
-			dst[i] = '1';
-			break;
-
-		case 2:
-			dst[i] = '2';
-			break;
-
-		case 3:
-			dst[i] = '3';
-			break;
-
-		case 4:
-			dst[i] = '4';
-			break;
-
-		case 5:
-			dst[i] = '5';
-			break;
-
-		case 6:
-			dst[i] = '6';
-			break;
-
-		case 7:
-			dst[i] = '7';
-			break;
-
-		case 8:
-			dst[i] = '8';
-			break;
-
-		case 9:
-			dst[i] = '9';
-			break;
-
-		}
-
-		value /= 10;
-	}
-
-	dst[end + 1] = '\0';
-}
-
-SV_INLINE b8 string_to_u32(u32* dst, char* str)
-{
-	u32 digits = string_size(str);
-	*dst = 0u;
-
-	if (digits == 0) return FALSE;
-
-	u32 mul = 10;
-	foreach(i, digits - 1)
-			mul *= 10;
-
-	foreach(i, digits) {
-
-		mul /= 10;
-		
-		char c = str[i];
-		u32 v;
+const char* string_parse_u64(const char* str, u64* value, b8* res);
+const char* string_parse_i64(const char* str, i64* value, b8* res);
+const char* string_parse_f32(const char* str, f32* value, b8* res);
+const char* string_parse_f64(const char* str, f64* value, b8* res);
 
-		switch (c) {
-			
-		case '0':
-			v = 0;
-			break;
-		case '1':
-			v = 1;
-			break;
-		case '2':
-			v = 2;
-			break;
-		case '3':
-			v = 3;
-			break;
-		case '4':
-			v = 4;
-			break;
-		case '5':
-			v = 5;
-			break;
-		case '6':
-			v = 6;
-			break;
-		case '7':
-			v = 7;
-			break;
-		case '8':
-			v = 8;
-			break;
-		case '9':
-			v = 9;
-			break;
+void string_from_u32(char* dst, u32 value);
+void string_from_u64(char* dst, u64 value);
 
-		default:
-			return FALSE;
-			
-		}
+// Fixed notation, rounded to the decimals (max 9)
+void string_from_f32(char* dst, f32 value, u32 decimals);
 
-		v *= mul;
-		*dst += v;
-	}
+// The shortest string that parses back to the same value, dst needs 20 chars
+void string_from_f32_shortest(char* dst, f32 value);
 
-	return TRUE;
-}
+b8 string_to_u32(u32* dst, const char* str);
 
 SV_INLINE b8 string_to_u32_hexadecimal(u32* dst, char* str)
 {
@@ -841,8 +351,7 @@ SV_INLINE b8 string_to_u32_hexadecimal(u32* dst, char* str)
 			
 		}
 
-		v *= digits - i;
-		*dst += v;
+		*dst = (*dst << 4) | v;
 	}
 
 	return TRUE;
@@ -1036,8 +545,7 @@ SV_INLINE b8 char_is_capital(u32 c)
 
 SV_INLINE const char* line_next(const char* it)
 {
-	while (*it != '\n' && *it != '\0')
-		++it;
+	it = string_find_char(it, '\n');
 
 	if (*it == '\n')
 		++it;
@@ -1052,119 +560,71 @@ SV_INLINE const char* line_jump_spaces(const char* it)
 	return it;
 }
 
-SV_INLINE const char* line_read_f32(const char* it, f32* value, b8* res)
+SV_INLINE b8 _line_is_end(const char* it, const char* delimiters, u32 delimiter_count)
 {
-	*value = 0.f;
-	it = line_jump_spaces(it);
-	
-	if (res) *res = FALSE;
-	const char* start = it;
+	if (*it == '\0' || *it == '\n' || *it == '\r')
+		return TRUE;
 
-	if (*it == '-') ++it;
-	
-	u32 dots = 0u;
-	
-	while (*it != '\0' && *it != ' ' && *it != '\n' && *it != '\r') {
-		if (!char_is_number(*it) && *it != '.')
-			return start;
-		
-		if (*it == '.')
-			++dots;
-		
-		++it;
-	}
-	
-	if (it == start || dots > 1) return start;
-	
-	u32 size = it - start;	
-	
-	char value_str[20u];
-	memory_copy(value_str, start, size);
-	value_str[size] = '\0';
-	// TODO: Use my own function
-	*value = (f32)atof(value_str);
-	
-	if (res) *res = TRUE;
-	
-	return it;
+	foreach(i, delimiter_count)
+		if (delimiters[i] == *it) return TRUE;
+
+	return FALSE;
 }
 
-SV_INLINE const char* line_read_i32(const char* it, i32* value, const char* delimiters, u32 delimiter_count, b8* pres)
+SV_INLINE const char* line_read_f32(const char* it, f32* value, b8* res)
 {
-	*value = 0;
 	it = line_jump_spaces(it);
 
-	if (pres) *pres = FALSE;
-	const char* start = it;
-	
-	if (*it == '-') ++it;
-	
-	while (*it != '\0' && *it != '\n' && *it != '\r') {
-		
-		b8 end = FALSE;
-		
-		foreach(i, delimiter_count)
-			if (delimiters[i] == *it) end = TRUE;
-		
-		if (end)
-			break;
-	    
-		if (!char_is_number(*it))
-			return start;
-		++it;
-	}
-	
-	if (it == start) return start;
-	
-	u32 size = it - start;
-	
-	char value_str[20u];
-	memory_copy(value_str, start, size);
-	value_str[size] = '\0';
-	// TODO: Use my own function
-	*value = atoi(value_str);
-	
-	if (pres) *pres = TRUE;
-	
-	return it;
+	b8 ok;
+	const char* end = string_parse_f32(it, value, &ok);
+
+	ok = ok && _line_is_end(end, " ", 1u);
+	if (res) *res = ok;
+
+	return ok ? end : it;
 }
 
-SV_INLINE const char* line_read_u32(const char* it, u32* value, const char* delimiters, u32 delimiter_count, b8* pres)
+SV_INLINE const char* line_read_f64(const char* it, f64* value, b8* res)
 {
-	*value = 0;
 	it = line_jump_spaces(it);
 
-	if (pres)* pres = FALSE;
-	const char* start = it;
+	b8 ok;
+	const char* end = string_parse_f64(it, value, &ok);
 
-	while (*it != '\0' && *it != '\n' && *it != '\r') {
+	ok = ok && _line_is_end(end, " ", 1u);
+	if (res) *res = ok;
 
-		b8 end = FALSE;
+	return ok ? end : it;
+}
 
-		foreach(i, delimiter_count)
-			if (delimiters[i] == *it) end = TRUE;
+SV_INLINE const char* line_read_i32(const char* it, i32* value, const char* delimiters, u32 delimiter_count, b8* pres)
+{
+	it = line_jump_spaces(it);
 
-		if (end)
-			break;
+	i64 n;
+	b8 ok;
+	const char* end = string_parse_i64(it, &n, &ok);
 
-		if (!char_is_number(*it))
-			return start;
-		++it;
-	}
+	ok = ok && n >= -2147483647 - 1 && n <= i32_max && _line_is_end(end, delimiters, delimiter_count);
+	*value = ok ? (i32)n : 0;
+	if (pres) *pres = ok;
 
-	if (it == start) return start;
+	return ok ? end : it;
+}
 
-	u32 size = it - start;
+SV_INLINE const char* line_read_u32(const char* it, u32* value, const char* delimiters, u32 delimiter_count, b8* pres)
+{
+	it = line_jump_spaces(it);
 
-	char value_str[20u];
-	memory_copy(value_str, start, size);
-	value_str[size] = '\0';
+	u64 n;
+	b8 ok;
+	const char* end = string_parse_u64(it, &n, &ok);
 
-	string_to_u32(value, value_str);
-	
-	if (pres) *pres = TRUE;
+	ok = ok && n <= u32_max && _line_is_end(end, delimiters, delimiter_count);
+	*value = ok ? (u32)n : 0u;
+	if (pres) *pres = ok;
 
-	return it;
+	return ok ? end : it;
 }
 
 SV_INLINE const char* line_read_v3(const char* it, v3* value, b8* res)
@@ -4,6 +4,10 @@
 #include "Hosebase/math.h"
 #include "Hosebase/input.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 SV_BEGIN_C_HEADER
 
 typedef enum {
@@ -121,6 +125,16 @@ b8 folder_remove(FilepathType type, const char* filepath);
 
 b8 file_date(FilepathType type, const char* filepath, Date* create, Date* last_write, Date* last_access);
 
+// Read-only view of the whole file, the pages are loaded when touched. Data is null for empty files
+typedef struct {
+	const u8* data;
+	u32 size;
+	u64 _handle;
+} FileView;
+
+b8   file_map(FilepathType type, const char* filepath, FileView* view);
+void file_unmap(FileView* view);
+
 typedef struct {
 	Date        create_date;
 	Date        last_write_date;
@@ -142,6 +156,20 @@ void folder_iterator_close(FolderIterator* iterator);
 
 #define foreach_file(it, path) for (FolderIterator it = folder_iterator_begin(path); it.has_next; folder_iterator_next(&it))
 
+// FILE WATCHER
+
+typedef u64 FileWatcher;
+
+// Returns 0 if the platform can't watch files, the changes have to be polled with file_date
+FileWatcher file_watcher_create();
+void        file_watcher_destroy(FileWatcher watcher);
+
+b8   file_watcher_add(FileWatcher watcher, FilepathType type, const char* filepath);
+void file_watcher_remove(FileWatcher watcher, FilepathType type, const char* filepath);
+
+// Pops a modified file, the filepath is returned as it was added
+b8 file_watcher_next(FileWatcher watcher, FilepathType* type, char* filepath);
+
 // CLIPBOARD
 
 b8          clipboard_write_ansi(const char* text);
@@ -161,6 +189,8 @@ typedef void(*TaskFn)(void* user_data);
 typedef struct {
 	volatile i32 completed;
 	u32 dispatched;
+	void* node; // Set by the task graphs
+	void* volatile watchers; // Task graph nodes waiting for the context to drain
 } TaskContext;
     
 Mutex mutex_create();
@@ -182,6 +212,110 @@ struct _LockGuard {
 
 #endif
 
+// Lightweight locks, they live in user memory and only enter the kernel when contended. Zero initialized means unlocked and none of them is recursive
+
+typedef struct {
+	volatile u32 state; // 0 unlocked, 1 locked, 2 locked with sleeping threads
+	u32 spin; // Average spins needed to take it, limits the spinning before sleeping
+} FastMutex;
+
+void fast_mutex_lock(FastMutex* mutex);
+b8   fast_mutex_try_lock(FastMutex* mutex);
+void fast_mutex_unlock(FastMutex* mutex);
+
+// New readers wait while a writer is waiting, the writers don't starve
+typedef struct {
+	volatile u32 state; // Reader count and writer bit
+	volatile u32 waiters;
+	FastMutex writer;
+} RWLock;
+
+void rwlock_read_lock(RWLock* lock);
+b8   rwlock_try_read_lock(RWLock* lock);
+void rwlock_read_unlock(RWLock* lock);
+void rwlock_write_lock(RWLock* lock);
+void rwlock_write_unlock(RWLock* lock);
+
+typedef struct {
+	volatile u32 sequence;
+	volatile u32 waiters;
+} CondVar;
+
+// The mutex is unlocked while waiting and locked again before returning. Can return spuriously, check the condition in a loop
+void condvar_wait(CondVar* cv, FastMutex* mutex);
+void condvar_signal(CondVar* cv);
+void condvar_broadcast(CondVar* cv);
+
+// Thread safe instance allocator, the iteration and the close are not guarded
+
+typedef struct {
+	InstanceAllocator allocator;
+	FastMutex lock;
+} SharedInstanceAllocator;
+
+SV_INLINE SharedInstanceAllocator shared_instance_allocator_init(u32 instance_size, u32 pool_size)
+{
+	SharedInstanceAllocator alloc;
+	alloc.allocator = instance_allocator_init(instance_size, pool_size);
+	memory_zero(&alloc.lock, sizeof(FastMutex));
+	return alloc;
+}
+
+SV_INLINE void* __impl__shared_instance_allocator_create(SharedInstanceAllocator* alloc, u32 line, const char* file)
+{
+	fast_mutex_lock(&alloc->lock);
+	void* ptr = __impl__instance_allocator_create(&alloc->allocator, line, file);
+	fast_mutex_unlock(&alloc->lock);
+	return ptr;
+}
+
+SV_INLINE void shared_instance_allocator_destroy(SharedInstanceAllocator* alloc, void* ptr)
+{
+	fast_mutex_lock(&alloc->lock);
+	instance_allocator_destroy(&alloc->allocator, ptr);
+	fast_mutex_unlock(&alloc->lock);
+}
+
+// The pointer is only safe while the instance is not destroyed by another thread
+SV_INLINE void* shared_instance_allocator_get(SharedInstanceAllocator* alloc, InstanceHandle handle)
+{
+	fast_mutex_lock(&alloc->lock);
+	void* ptr = instance_allocator_get(&alloc->allocator, handle);
+	fast_mutex_unlock(&alloc->lock);
+	return ptr;
+}
+
+SV_INLINE u32 shared_instance_allocator_size(SharedInstanceAllocator* alloc)
+{
+	return alloc->allocator.size;
+}
+
+SV_INLINE void shared_instance_allocator_close(SharedInstanceAllocator* alloc)
+{
+	instance_allocator_close(&alloc->allocator);
+}
+
+#define shared_instance_allocator_create(alloc) __impl__shared_instance_allocator_create(alloc, __LINE__, __FILE__)
+
+#ifdef __cplusplus
+
+struct _ReadGuard {
+	RWLock* l;
+	_ReadGuard(RWLock* lock) : l(lock) { rwlock_read_lock(l); }
+	~_ReadGuard() { rwlock_read_unlock(l); }
+};
+
+struct _WriteGuard {
+	RWLock* l;
+	_WriteGuard(RWLock* lock) : l(lock) { rwlock_write_lock(l); }
+	~_WriteGuard() { rwlock_write_unlock(l); }
+};
+
+#define SV_READ_GUARD(lock, name) _ReadGuard name(&lock);
+#define SV_WRITE_GUARD(lock, name) _WriteGuard name(&lock);
+
+#endif
+
 typedef enum {
 	ThreadPrority_Highest,
 	ThreadPrority_High,
@@ -197,8 +331,48 @@ void   thread_sleep(u64 millis);
 void   thread_yield();
 u64    thread_id();
 
+// Return addresses of the calling thread from its caller, returns the count. Only for debugging
+u32 thread_stack_trace(void** frames, u32 max);
+
 void thread_configure(Thread thread, const char* name, u64 affinity_mask, ThreadPrority priority);
 
+// CPU TOPOLOGY
+
+#define SV_CPU_MAX 1024
+
+// Set of logical processors indexed by the OS id
+typedef struct {
+	u64 bits[SV_CPU_MAX / 64];
+} CpuMask;
+
+SV_INLINE void cpu_mask_set(CpuMask* mask, u32 cpu) { if (cpu < SV_CPU_MAX) mask->bits[cpu / 64] |= 1ULL << (u64)(cpu % 64); }
+SV_INLINE void cpu_mask_clear(CpuMask* mask, u32 cpu) { if (cpu < SV_CPU_MAX) mask->bits[cpu / 64] &= ~(1ULL << (u64)(cpu % 64)); }
+SV_INLINE b8 cpu_mask_test(const CpuMask* mask, u32 cpu) { return cpu < SV_CPU_MAX && (mask->bits[cpu / 64] & (1ULL << (u64)(cpu % 64))) != 0; }
+
+typedef struct {
+	u32 id; // Logical processor index used by the OS
+	u32 core; // Physical core, shared by the SMT siblings
+	u32 smt_index; // Position inside the core, 0 for the first sibling
+	u32 package;
+	u32 numa_node;
+	u32 performance; // Relative between the processors of this machine, lower in the efficiency cores of hybrid cpus
+} CpuInfo;
+
+// Processors that the process is allowed to run on, sorted by id. Queried once at initialization
+const CpuInfo* cpu_topology(u32* count);
+u32            cpu_numa_node_count();
+
+// Overrides the affinity_mask of thread_configure, it isn't limited to the first 64 processors
+b8 thread_set_affinity(Thread thread, const CpuMask* mask);
+
+// Where the task workers are pinned
+typedef enum {
+	TaskPlacement_PhysicalFirst, // One worker per physical core, the fastest cores first, the SMT siblings are used at the end
+	TaskPlacement_NumaNode, // Same order, but each worker can run in any processor of its NUMA node
+	TaskPlacement_Compact, // Consecutive logical processors
+	TaskPlacement_None, // Not pinned
+} TaskPlacement;
+
 typedef struct {
 	TaskFn fn;
 	const void* data;
@@ -211,33 +385,323 @@ typedef struct
 	u32 index;
 } ForeachTask;
 
+// The lanes are served in order, a task of a lower lane only starts when the upper lanes are empty
+typedef enum {
+	TaskPriority_High,
+	TaskPriority_Normal,
+	TaskPriority_Low,
+	TaskPriority_MaxEnum
+} TaskPriority;
+
+typedef struct {
+	u64 executed;
+	f64 latency_avg; // Seconds from the dispatch to the start of the task
+	f64 latency_max;
+} TaskLaneStats;
+
 void task_dispatch(TaskDesc* tasks, u32 task_count, TaskContext* context);
+void task_dispatch_priority(TaskDesc* tasks, u32 task_count, TaskContext* context, TaskPriority priority);
 void task_wait(TaskContext* context);
 b8 task_running(TaskContext* context);
 
-#define foreach_multithreaded(_fn, _count, _data, _ctx) \
-	do                                                  \
-	{                                                   \
-		foreach (i, (_count))                           \
-		{                                               \
-			ForeachTask task;                           \
-			task.data = (_data);                        \
-			task.index = i;                             \
-			TaskDesc desc;                              \
-			desc.fn = _fn;                              \
-			desc.size = sizeof(ForeachTask);            \
-			desc.data = &task;                          \
-			task_dispatch(&desc, 1, _ctx);              \
-		}                                               \
-	} while (0)
+// Counters accumulated since the initialization, only written by the owner worker
+typedef struct {
+	u64 executed;
+	f64 busy_time; // Seconds executing tasks from the worker loop
+	f64 idle_time; // Seconds searching or sleeping without work
+	u64 steal_attempts;
+	u64 steal_successes;
+	u32 queue_high_water; // Maximum tasks in one of the worker deques
+	f64 wait_time; // Accumulated seconds from the dispatch to the start of the executed tasks
+	f64 wait_max;
+} TaskWorkerStats;
+
+u32             task_worker_count();
+TaskWorkerStats task_worker_stats(u32 worker);
+
+// Maximum number of workers executing tasks of the lane at the same time, 0 removes the limit
+void task_lane_worker_limit(TaskPriority priority, u32 limit);
+
+TaskLaneStats task_lane_stats(TaskPriority priority);
+void          task_lane_stats_reset();
+
+typedef void(*TaskRangeFn)(u32 begin, u32 end, void* data);
+typedef void(*TaskReduceFn)(u32 begin, u32 end, void* data, void* result);
+typedef void(*TaskJoinFn)(void* dst, const void* src);
+
+// Runs fn over [begin, end) splitting the range in tasks of at least 'grain' elements.
+// The ranges are subdivided again when they are stolen by idle threads. Zero grain computes one from the thread count
+void task_parallel_for(u32 begin, u32 end, u32 grain, TaskRangeFn fn, void* data, TaskContext* context);
+
+// Blocks until the reduction is done. 'result' contains the identity value and receives the joined result.
+// Each range is accumulated into a partial result initialized with the identity
+void task_parallel_reduce(u32 begin, u32 end, u32 grain, TaskReduceFn fn, TaskJoinFn join_fn, void* data, void* result, u32 result_size);
+
+// Blocks until the array is sorted. Sorts a run per worker with array_sort and merges them in parallel passes
+void task_parallel_sort(void* data, u32 count, u32 stride, void* fn);
+
+// array_radix_sort_* with the key histograms computed by the workers, the scatter passes are sequential
+void task_parallel_radix_sort_u32(void* data, u32 count, u32 stride, u32 key_offset, void* scratch);
+void task_parallel_radix_sort_u64(void* data, u32 count, u32 stride, u32 key_offset, void* scratch);
+void task_parallel_radix_sort_f32(void* data, u32 count, u32 stride, u32 key_offset, void* scratch);
+
+// Calls fn once per index with a ForeachTask, the indices are executed in chunks
+void task_foreach(TaskFn fn, u32 count, void* data, TaskContext* context);
+
+#define foreach_multithreaded(_fn, _count, _data, _ctx) task_foreach((_fn), (_count), (_data), (_ctx))
+
+// TASK GRAPHS
+
+typedef u64 TaskGraph;
+typedef u32 TaskNode;
+
+TaskGraph task_graph_create();
+void      task_graph_destroy(TaskGraph graph);
+
+// The data is copied into the graph, it can be modified between runs with task_graph_data
+TaskNode task_graph_add(TaskGraph graph, TaskFn fn, const void* data, u32 size);
+
+// The predecessor must be added before the node, this keeps the graph acyclic
+void task_graph_depend(TaskGraph graph, TaskNode node, TaskNode predecessor);
+
+// The node is dispatched once the context is drained, no worker waits for it. The context must stay valid until the node starts
+void task_graph_depend_context(TaskGraph graph, TaskNode node, TaskContext* context);
+
+// The tasks dispatched with this context are part of the node, the successors wait for them too
+TaskContext* task_graph_context(TaskGraph graph, TaskNode node);
+void*        task_graph_data(TaskGraph graph, TaskNode node);
+
+// Dispatches the nodes without predecessors, the rest are dispatched when their predecessors finish.
+// The context is completed when the whole graph is done. A graph can't be run twice at the same time
+void task_graph_run(TaskGraph graph, TaskContext* context);
 
 void task_reserve_thread(ThreadMainFn main_fn, void* main_data, TaskContext* context);
 
 void task_join();
 
+// SCRATCH MEMORY
+
+// Temporary memory of the calling thread. Every thread has its own allocators, the tasks don't contend for the heap.
+// The scopes nest, scratch_end frees everything allocated since its scratch_begin
+typedef struct {
+	LinearAllocator* allocator;
+	LinearAllocatorMark mark;
+} Scratch;
+
+Scratch scratch_begin();
+// For functions that allocate their result in a scratch of the caller, it returns the other allocator of the thread
+Scratch scratch_begin_conflict(const LinearAllocator* conflict);
+void    scratch_end(Scratch scratch);
+
+// The threads from thread_create release it when they finish, the main thread in platform_close
+void scratch_thread_close();
+
+#define scratch_push(scratch, size) linear_allocator_push((scratch).allocator, size)
+#define scratch_push_array(scratch, T, count) linear_allocator_push_array((scratch).allocator, T, count)
+
+// ASYNC FILE READING
+
+typedef u64 FileRead;
+
+typedef struct {
+	u8* data; // Owned by the callback, free it with memory_free. Null if the read failed or was cancelled
+	u32 size;
+	b8 success;
+	b8 cancelled;
+	void* user_data;
+} FileReadResult;
+
+typedef void(*FileReadFn)(FileReadResult* result);
+
+typedef struct {
+	FilepathType type;
+	const char* filepath;
+	FileReadFn callback;
+	void* user_data;
+	b8 text; // Null terminated like file_read_text
+} FileReadDesc;
+
+// The callback runs as a task and the context is completed after it. The returned handle can cancel the read
+FileRead file_read_async(FilepathType type, const char* filepath, FileReadFn callback, void* user_data, TaskContext* context);
+void     file_read_async_batch(const FileReadDesc* reads, u32 count, TaskContext* context, FileRead* handles);
+
+// Returns FALSE if the callback already started, otherwise it receives the cancelled flag
+b8 file_read_cancel(FileRead read);
+
 u32 interlock_increment_u32(volatile u32* n);
 u32 interlock_decrement_u32(volatile u32* n);
 
+// ATOMICS
+
+// Same values as the GCC builtins
+typedef enum {
+	MemoryOrder_Relaxed = 0,
+	MemoryOrder_Acquire = 2,
+	MemoryOrder_Release = 3,
+	MemoryOrder_AcqRel = 4,
+	MemoryOrder_SeqCst = 5,
+} MemoryOrder;
+
+// The fetch functions return the previous value. The cas functions write the current value in expected when they fail
+
+#if defined(_MSC_VER)
+
+#if defined(_M_ARM64)
+
+// The ARM64 loads and stores are not ordered, the acquire and release need ldar and stlr. The interlocked functions are full barriers
+
+SV_INLINE u32 atomic_load_u32(const volatile u32* p, MemoryOrder order) { return (order == MemoryOrder_Relaxed) ? __iso_volatile_load32((const volatile __int32*)p) : __ldar32((volatile unsigned __int32*)p); }
+SV_INLINE u64 atomic_load_u64(const volatile u64* p, MemoryOrder order) { return (order == MemoryOrder_Relaxed) ? __iso_volatile_load64((const volatile __int64*)p) : __ldar64((volatile unsigned __int64*)p); }
+SV_INLINE void* atomic_load_ptr(void* const volatile* p, MemoryOrder order) { return (void*)atomic_load_u64((const volatile u64*)p, order); }
+
+SV_INLINE void atomic_store_u32(volatile u32* p, u32 v, MemoryOrder order) { if (order == MemoryOrder_Relaxed) __iso_volatile_store32((volatile __int32*)p, (__int32)v); else __stlr32((volatile unsigned __int32*)p, v); }
+SV_INLINE void atomic_store_u64(volatile u64* p, u64 v, MemoryOrder order) { if (order == MemoryOrder_Relaxed) __iso_volatile_store64((volatile __int64*)p, (__int64)v); else __stlr64((volatile unsigned __int64*)p, v); }
+SV_INLINE void atomic_store_ptr(void* volatile* p, void* v, MemoryOrder order) { atomic_store_u64((volatile u64*)p, (u64)v, order); }
+
+SV_INLINE void atomic_fence(MemoryOrder order) { if (order == MemoryOrder_Relaxed) _ReadWriteBarrier(); else __dmb(_ARM64_BARRIER_ISH); }
+
+#elif defined(_M_X64)
+
+// The x64 loads and stores already have acquire and release semantics, the orders only limit the compiler
+
+SV_INLINE u32 atomic_load_u32(const volatile u32* p, MemoryOrder order) { u32 v = *p; _ReadWriteBarrier(); return v; }
+SV_INLINE u64 atomic_load_u64(const volatile u64* p, MemoryOrder order) { u64 v = *p; _ReadWriteBarrier(); return v; }
+SV_INLINE void* atomic_load_ptr(void* const volatile* p, MemoryOrder order) { void* v = *p; _ReadWriteBarrier(); return v; }
+
+SV_INLINE void atomic_store_u32(volatile u32* p, u32 v, MemoryOrder order) { if (order == MemoryOrder_SeqCst) _InterlockedExchange((volatile long*)p, (long)v); else { _ReadWriteBarrier(); *p = v; } }
+SV_INLINE void atomic_store_u64(volatile u64* p, u64 v, MemoryOrder order) { if (order == MemoryOrder_SeqCst) _InterlockedExchange64((volatile long long*)p, (long long)v); else { _ReadWriteBarrier(); *p = v; } }
+SV_INLINE void atomic_store_ptr(void* volatile* p, void* v, MemoryOrder order) { if (order == MemoryOrder_SeqCst) _InterlockedExchangePointer(p, v); else { _ReadWriteBarrier(); *p = v; } }
+
+SV_INLINE void atomic_fence(MemoryOrder order) { if (order == MemoryOrder_SeqCst) _mm_mfence(); else _ReadWriteBarrier(); }
+
+#else
+#error "The MSVC atomics are only implemented for x64 and ARM64"
+#endif
+
+SV_INLINE u32 atomic_exchange_u32(volatile u32* p, u32 v, MemoryOrder order) { return (u32)_InterlockedExchange((volatile long*)p, (long)v); }
+SV_INLINE u64 atomic_exchange_u64(volatile u64* p, u64 v, MemoryOrder order) { return (u64)_InterlockedExchange64((volatile long long*)p, (long long)v); }
+SV_INLINE void* atomic_exchange_ptr(void* volatile* p, void* v, MemoryOrder order) { return _InterlockedExchangePointer(p, v); }
+
+SV_INLINE u32 atomic_fetch_add_u32(volatile u32* p, u32 v, MemoryOrder order) { return (u32)_InterlockedExchangeAdd((volatile long*)p, (long)v); }
+SV_INLINE u64 atomic_fetch_add_u64(volatile u64* p, u64 v, MemoryOrder order) { return (u64)_InterlockedExchangeAdd64((volatile long long*)p, (long long)v); }
+
+SV_INLINE b8 atomic_cas_u32(volatile u32* p, u32* expected, u32 desired, MemoryOrder order)
+{
+	u32 prev = (u32)_InterlockedCompareExchange((volatile long*)p, (long)desired, (long)*expected);
+	if (prev == *expected) return TRUE;
+	*expected = prev;
+	return FALSE;
+}
+
+SV_INLINE b8 atomic_cas_u64(volatile u64* p, u64* expected, u64 desired, MemoryOrder order)
+{
+	u64 prev = (u64)_InterlockedCompareExchange64((volatile long long*)p, (long long)desired, (long long)*expected);
+	if (prev == *expected) return TRUE;
+	*expected = prev;
+	return FALSE;
+}
+
+SV_INLINE b8 atomic_cas_ptr(void* volatile* p, void** expected, void* desired, MemoryOrder order)
+{
+	void* prev = _InterlockedCompareExchangePointer(p, desired, *expected);
+	if (prev == *expected) return TRUE;
+	*expected = prev;
+	return FALSE;
+}
+
+#else
+
+// The failure of a cas can't have release semantics
+#define _atomic_failure_order(order) ((order) == MemoryOrder_AcqRel ? MemoryOrder_Acquire : ((order) == MemoryOrder_Release ? MemoryOrder_Relaxed : (order)))
+
+SV_INLINE u32 atomic_load_u32(const volatile u32* p, MemoryOrder order) { return __atomic_load_n(p, order); }
+SV_INLINE u64 atomic_load_u64(const volatile u64* p, MemoryOrder order) { return __atomic_load_n(p, order); }
+SV_INLINE void* atomic_load_ptr(void* const volatile* p, MemoryOrder order) { return __atomic_load_n(p, order); }
+
+SV_INLINE void atomic_store_u32(volatile u32* p, u32 v, MemoryOrder order) { __atomic_store_n(p, v, order); }
+SV_INLINE void atomic_store_u64(volatile u64* p, u64 v, MemoryOrder order) { __atomic_store_n(p, v, order); }
+SV_INLINE void atomic_store_ptr(void* volatile* p, void* v, MemoryOrder order) { __atomic_store_n(p, v, order); }
+
+SV_INLINE u32 atomic_exchange_u32(volatile u32* p, u32 v, MemoryOrder order) { return __atomic_exchange_n(p, v, order); }
+SV_INLINE u64 atomic_exchange_u64(volatile u64* p, u64 v, MemoryOrder order) { return __atomic_exchange_n(p, v, order); }
+SV_INLINE void* atomic_exchange_ptr(void* volatile* p, void* v, MemoryOrder order) { return __atomic_exchange_n(p, v, order); }
+
+SV_INLINE u32 atomic_fetch_add_u32(volatile u32* p, u32 v, MemoryOrder order) { return __atomic_fetch_add(p, v, order); }
+SV_INLINE u64 atomic_fetch_add_u64(volatile u64* p, u64 v, MemoryOrder order) { return __atomic_fetch_add(p, v, order); }
+
+SV_INLINE b8 atomic_cas_u32(volatile u32* p, u32* expected, u32 desired, MemoryOrder order) { return __atomic_compare_exchange_n(p, expected, desired, FALSE, order, _atomic_failure_order(order)); }
+SV_INLINE b8 atomic_cas_u64(volatile u64* p, u64* expected, u64 desired, MemoryOrder order) { return __atomic_compare_exchange_n(p, expected, desired, FALSE, order, _atomic_failure_order(order)); }
+SV_INLINE b8 atomic_cas_ptr(void* volatile* p, void** expected, void* desired, MemoryOrder order) { return __atomic_compare_exchange_n(p, expected, desired, FALSE, order, _atomic_failure_order(order)); }
+
+SV_INLINE void atomic_fence(MemoryOrder order) { __atomic_thread_fence(order); }
+
+#endif
+
+// The f64 is stored as its bits, for the timestamps written by concurrent readers
+SV_INLINE void atomic_store_f64(volatile f64* p, f64 v, MemoryOrder order)
+{
+	union { f64 f; u64 u; } bits;
+	bits.f = v;
+	atomic_store_u64((volatile u64*)p, bits.u, order);
+}
+
+// LOCK-FREE CONTAINERS
+
+#define SV_CACHE_LINE 64
+
+// Single producer and single consumer ring of fixed size elements. The capacity is rounded up to a power of two
+typedef struct {
+	u8* data;
+	u32 stride;
+	u32 mask;
+	u8 _pad0[SV_CACHE_LINE];
+	volatile u32 head; // Consumer
+	u32 cached_tail;
+	u8 _pad1[SV_CACHE_LINE];
+	volatile u32 tail; // Producer
+	u32 cached_head;
+	u8 _pad2[SV_CACHE_LINE];
+} SPSCRing;
+
+void spsc_ring_init(SPSCRing* ring, u32 stride, u32 capacity);
+void spsc_ring_close(SPSCRing* ring);
+b8   spsc_ring_push(SPSCRing* ring, const void* data); // Returns FALSE if it's full
+b8   spsc_ring_pop(SPSCRing* ring, void* data); // Returns FALSE if it's empty
+
+// Bounded queue for any number of producers and consumers. The capacity is rounded up to a power of two
+typedef struct {
+	volatile u32* sequences;
+	u8* data;
+	u32 stride;
+	u32 mask;
+	u8 _pad0[SV_CACHE_LINE];
+	volatile u32 enqueue_pos;
+	u8 _pad1[SV_CACHE_LINE];
+	volatile u32 dequeue_pos;
+	u8 _pad2[SV_CACHE_LINE];
+} MPMCQueue;
+
+void mpmc_queue_init(MPMCQueue* queue, u32 stride, u32 capacity);
+void mpmc_queue_close(MPMCQueue* queue);
+b8   mpmc_queue_push(MPMCQueue* queue, const void* data); // Returns FALSE if it's full
+b8   mpmc_queue_pop(MPMCQueue* queue, void* data); // Returns FALSE if it's empty
+
+// Unbounded queue for any number of producers and one consumer. The node is embedded in the element and must live until it's popped
+typedef struct MPSCNode {
+	struct MPSCNode* volatile next;
+} MPSCNode;
+
+typedef struct {
+	MPSCNode* volatile head; // Producers
+	u8 _pad0[SV_CACHE_LINE];
+	MPSCNode* tail; // Consumer
+	MPSCNode stub;
+} MPSCQueue;
+
+void      mpsc_queue_init(MPSCQueue* queue);
+void      mpsc_queue_push(MPSCQueue* queue, MPSCNode* node);
+MPSCNode* mpsc_queue_pop(MPSCQueue* queue); // Returns NULL if it's empty or the next push is not linked yet
+
 // DYNAMIC LIBRARIES
 
 typedef u64 Library;
@@ -257,6 +721,12 @@ typedef struct {
 		const char* title;
 	} window;
 
+	struct {
+		TaskPlacement placement;
+		u32 worker_count; // 0 creates one worker per available processor, leaving one for the main thread
+		CpuMask exclude; // The workers never run on these processors
+	} task;
+
 } PlatformInitializeDesc;
 	
 b8 platform_initialize(const PlatformInitializeDesc* desc);
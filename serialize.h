@@ -268,6 +268,7 @@ typedef struct {
 	u32 size;
 	u32 cursor;
 	b8 extern_data;
+	FileView view; // The file deserializers read from a mapped view
 } Deserializer;
 
 SV_INLINE void deserializer_read(Deserializer* s, void* data, u32 size)
@@ -294,13 +295,17 @@ SV_INLINE void deserializer_ignore(Deserializer* s, u32 size)
 SV_INLINE b8 deserializer_begin_file(Deserializer* s, FilepathType type, const char* filepath)
 {
 	s->cursor = 0;
-	s->extern_data = FALSE;
-	if (file_read_binary(type, filepath, &s->data, &s->size)) {
+	s->extern_data = TRUE;
+	if (file_map(type, filepath, &s->view)) {
 
+		s->data = (u8*)s->view.data;
+		s->size = s->view.size;
 		deserializer_read(s, &s->version, sizeof(u32));
 		return TRUE;
 	}
 
+	s->data = NULL;
+	s->size = 0;
 	return FALSE;
 }
 
@@ -311,10 +316,12 @@ SV_INLINE void deserializer_begin_buffer(Deserializer* s, void* buffer, u32 size
 	s->data = (u8*)buffer;
 	s->size = size;
 	s->version = SERIALIZER_VERSION;
+	memory_zero(&s->view, sizeof(FileView));
 }
 
 SV_INLINE void deserializer_end_file(Deserializer* s)
 {
+	file_unmap(&s->view);
 	if (s->data && !s->extern_data) memory_free(s->data);
 }
 
@@ -410,13 +417,16 @@ SV_INLINE void deserialize_string(Deserializer* s, char* str, u32 buffer_size)
 	if (s->cursor < s->size) {
 		
 		u32 start = s->cursor;
-		while (s->data[s->cursor] != '\0' && s->cursor < s->size) {
+		// The bound is checked first, a mapped file ends at the last byte
+		while (s->cursor < s->size && s->data[s->cursor] != '\0') {
 			++s->cursor;
 		}
 
 		if (s->cursor != s->size) {
 
-			memory_copy(str, s->data + start, s->cursor - start + 1);
+			u32 size = SV_MIN(s->cursor - start, buffer_size - 1);
+			memory_copy(str, s->data + start, size);
+			str[size] = '\0';
 			s->cursor++;
 			return;
 		}
@@ -3,17 +3,17 @@
 
 #define EXTENSION_MAX 10
 #define ASSET_TYPE_MAX 20
-#define ASSET_TABLE_SIZE 200
 
 #define AssetFlag_Valid SV_BIT(0)
 #define AssetFlag_FromFile SV_BIT(1)
+#define AssetFlag_Loading SV_BIT(2) // In the table but not loaded yet, the other loaders wait
+#define AssetFlag_Failed SV_BIT(3) // The load failed while others were waiting, freed when they release it
 
 typedef struct {
 	u64 hash;
 	f64 last_update;
-	Date last_file_update; // Used in hot reloading
+	Date last_file_update; // Used in hot reloading when the files can't be watched
 	u32 flags;
-	u32 next; // This is used in the hash table and should be initialized with all ones at the begining
 	volatile u32 reference_counter;
 
 	// TODO: Move this to a separate buffer
@@ -40,7 +40,11 @@ typedef struct {
 	u32 asset_free_count;
 
 	// Asset table
-	u32 asset_table[ASSET_TABLE_SIZE]; // At the beggining this table should be initialized with all ones
+	HashMap(u32) asset_table; // Filepath hash to asset index
+	RWLock lock; // Guards the table and the asset memory, the lookups only need to read
+
+	FastMutex loading_mutex;
+	CondVar loading_cv; // Broadcasted when an asset stops loading
 
 } AssetType;
 
@@ -49,6 +53,7 @@ typedef struct {
 	u32 type_count;
 
 	b8 hot_reloading;
+	FileWatcher watcher; // Only with hot reloading, 0 if the platform needs polling
 } AssetSystemData;
 
 static AssetSystemData* sys;
@@ -73,16 +78,21 @@ inline void asset_decompose(Asset asset, u32* index, AssetType** type)
 	}
 }
 
+SV_INLINE AssetHeader* asset_type_ptr(AssetType* type, Asset asset)
+{
+	u32 index = asset & 0xFFFFFFFF;
+	return (AssetHeader*)(type->asset_memory + (index * (sizeof(AssetHeader) + type->asset_size)));
+}
+
 inline AssetHeader* asset_decompose_ptr(Asset asset)
 {
-	u32 index;
 	AssetType* type;
-	asset_decompose(asset, &index, &type);
+	asset_decompose(asset, NULL, &type);
 
 	if (type == NULL)
 		return NULL;
 
-	return (AssetHeader*)(type->asset_memory + (index * (sizeof(AssetHeader) + type->asset_size)));
+	return asset_type_ptr(type, asset);
 }
 
 inline u64 compute_asset_filepath_hash(const char* filepath)
@@ -93,32 +103,8 @@ inline u64 compute_asset_filepath_hash(const char* filepath)
 
 static Asset find_asset_in_table(AssetType* type, u64 hash)
 {
-	u32 asset_stride = sizeof(AssetHeader) + type->asset_size;
-
-	u32 index = type->asset_table[hash % ASSET_TABLE_SIZE];
-
-	if (index != u32_max) {
-		AssetHeader* next = (AssetHeader*)(type->asset_memory + (index * asset_stride));
-
-		while (next->hash != hash) {
-
-			if (next->next == u32_max) {
-				next = NULL;
-				break;
-			}
-			else {
-				next = (AssetHeader*)(type->asset_memory + (next->next * asset_stride));
-			}
-		}
-
-		if (next) {
-			u32 index = ((u8*)next - type->asset_memory) / asset_stride;
-
-			return asset_handle(index, type);
-		}
-	}
-
-	return 0;
+	u32* index = (u32*)hashmap_get(&type->asset_table, hash);
+	return (index != NULL) ? asset_handle(*index, type) : 0;
 }
 
 static void store_asset_in_table(Asset asset, u64 hash)
@@ -130,53 +116,14 @@ static void store_asset_in_table(Asset asset, u64 hash)
 	if (type == NULL)
 		return;
 
-	u32 asset_stride = sizeof(AssetHeader) + type->asset_size;
-	u32 index = type->asset_table[hash % ASSET_TABLE_SIZE];
-
-	if (index != u32_max) {
-		AssetHeader* next = (AssetHeader*)(type->asset_memory + (index * asset_stride));
-
-		while (next->hash != hash) {
-
-			if (next->next == u32_max) {
-				next->next = asset_index;
-			}
-			
-			next = (AssetHeader*)(type->asset_memory + (next->next * asset_stride));
-		}
-	}
-	else type->asset_table[hash % ASSET_TABLE_SIZE] = asset_index;
+	u32* index = (u32*)hashmap_insert(&type->asset_table, hash, NULL);
+	if (index != NULL)
+		*index = asset_index;
 }
 
 static void remove_asset_in_table(AssetType* type, u64 hash)
 {
-	u32 asset_stride = sizeof(AssetHeader) + type->asset_size;
-	u32 index = type->asset_table[hash % ASSET_TABLE_SIZE];
-
-	if (index != u32_max) {
-		AssetHeader* next = (AssetHeader*)(type->asset_memory + (index * asset_stride));
-		AssetHeader* parent = NULL;
-
-		while (next->hash != hash) {
-
-			if (next->next == u32_max) {
-				break;
-			}
-
-			parent = next;
-			next = (AssetHeader*)(type->asset_memory + (next->next * asset_stride));
-		}
-
-		if (next->hash == hash) {
-
-			if (parent) {
-				parent->next = next->next;
-			}
-			else {
-				type->asset_table[hash % ASSET_TABLE_SIZE] = u32_max;
-			}
-		}
-	}
+	hashmap_erase(&type->asset_table, hash);
 }
 
 static Asset allocate_asset(AssetType* type, u64 hash)
@@ -211,9 +158,8 @@ static Asset allocate_asset(AssetType* type, u64 hash)
 	// Initialize
 	{
 		AssetHeader* asset = (AssetHeader*)(type->asset_memory + (asset_index * asset_stride));
-		asset->flags |= AssetFlag_Valid;
+		asset->flags |= AssetFlag_Valid | AssetFlag_Loading;
 		asset->hash = hash;
-		asset->next = u32_max;
 		asset->last_update = timer_now();
 	}
 
@@ -236,7 +182,14 @@ static void free_asset(Asset asset)
 	u32 asset_stride = sizeof(AssetHeader) + type->asset_size;
 
 	AssetHeader* header = (AssetHeader*)(type->asset_memory + (asset_index * asset_stride));
-	remove_asset_in_table(type, header->hash);
+
+	// A failed asset is already out of the table, the hash can belong to a new one
+	u32* table_index = (u32*)hashmap_get(&type->asset_table, header->hash);
+	if (table_index != NULL && *table_index == asset_index)
+		remove_asset_in_table(type, header->hash);
+
+	if (sys->watcher && header->flags & AssetFlag_FromFile)
+		file_watcher_remove(sys->watcher, FilepathType_Asset, header->text);
 
 	memory_zero(header, asset_stride);
 
@@ -300,6 +253,14 @@ b8 _asset_initialize(b8 hot_reloading)
 
 	sys->hot_reloading = hot_reloading;
 
+	if (hot_reloading) {
+
+		sys->watcher = file_watcher_create();
+
+		if (sys->watcher == 0)
+			SV_LOG_INFO("The files can't be watched, the hot reloading polls the assets\n");
+	}
+
 	return TRUE;
 }
 
@@ -328,26 +289,91 @@ void _asset_close()
 
 			if (type->asset_memory)
 				memory_free(type->asset_memory);
+
+			hashmap_close(&type->asset_table);
 		}
 
+		file_watcher_destroy(sys->watcher);
 		memory_free(sys);
 	}
 }
 
+// The assets are only freed in this thread, but the asset memory can grow while reloading. The asset is reloaded in a temporal copy
+static void reload_asset(AssetType* type, Asset asset_handle)
+{
+	char filepath[FILE_PATH_SIZE];
+	void* data = memory_allocate(type->asset_size);
+
+	rwlock_read_lock(&type->lock);
+
+	AssetHeader* asset = asset_decompose_ptr(asset_handle);
+	string_copy(filepath, asset->text, FILE_PATH_SIZE);
+	memory_copy(data, asset + 1, type->asset_size);
+
+	rwlock_read_unlock(&type->lock);
+
+	b8 reloaded = type->reload_file_fn(data, filepath);
+
+	rwlock_write_lock(&type->lock);
+
+	asset = asset_decompose_ptr(asset_handle);
+	memory_copy(asset + 1, data, type->asset_size);
+
+	rwlock_write_unlock(&type->lock);
+
+	memory_free(data);
+
+	if (reloaded) {
+		SV_LOG_INFO("Asset '%s' reloaded from file '%s'\n", type->name, filepath);
+	}
+	else {
+		SV_LOG_ERROR("Asset '%s' can't be reloaded from file '%s'\n", type->name, filepath);
+	}
+}
+
+static void reload_watched_assets()
+{
+	char filepath[FILE_PATH_SIZE];
+
+	while (file_watcher_next(sys->watcher, NULL, filepath)) {
+
+		AssetType* type = find_asset_type_from_filepath(filepath);
+
+		if (type == NULL)
+			continue;
+
+		rwlock_read_lock(&type->lock);
+
+		Asset asset = find_asset_in_table(type, compute_asset_filepath_hash(filepath));
+		b8 from_file = asset && (asset_decompose_ptr(asset)->flags & AssetFlag_FromFile);
+
+		rwlock_read_unlock(&type->lock);
+
+		if (from_file)
+			reload_asset(type, asset);
+	}
+}
+
 void _asset_update()
 {
 	u32 frame = core.frame_count;
 
+	// Only the modified files are notified
+	if (sys->watcher)
+		reload_watched_assets();
+
 	const u32 update_rate = 5;
 
 	// Reduce the updates
-	if (frame % update_rate != 0)
+	if (frame % update_rate != 0 || sys->type_count == 0)
 		return;
 
 	AssetType* type = sys->types + ((frame / update_rate) % sys->type_count);
 
 	f64 now = timer_now();
 
+	rwlock_write_lock(&type->lock);
+
 	foreach(i, type->asset_count) {
 
 		AssetHeader* asset = (AssetHeader*)(type->asset_memory + (i * (sizeof(AssetHeader) + type->asset_size)));
@@ -356,7 +382,10 @@ void _asset_update()
 
 			if (asset->reference_counter == 0) {
 
-				if (now - asset->last_update > type->unused_time) {
+				if (asset->flags & AssetFlag_Failed) {
+					free_asset(asset_handle(i, type));
+				}
+				else if (now - asset->last_update > type->unused_time) {
 
 					type->free_fn(asset + 1);
 
@@ -376,36 +405,52 @@ void _asset_update()
 		}
 	}
 
-	// Hot reloading
-	if (sys->hot_reloading) {
+	rwlock_write_unlock(&type->lock);
 
-		foreach(i, type->asset_count) {
+	// Hot reloading without watcher
+	if (sys->hot_reloading && sys->watcher == 0) {
 
-			AssetHeader* asset = (AssetHeader*)(type->asset_memory + (i * (sizeof(AssetHeader) + type->asset_size)));
+		u64 flags = AssetFlag_FromFile | AssetFlag_Valid;
 
-			u64 flags = AssetFlag_FromFile | AssetFlag_Valid;
+		// The lock is only held to read the asset, the file date is queried without it
+		for (u32 i = 0; ; ++i) {
 
-			if (asset->flags & flags == flags) {
+			char filepath[FILE_PATH_SIZE];
+			Date last_file_update;
+			b8 from_file = FALSE;
 
-				const char* filepath = asset->text;
+			rwlock_read_lock(&type->lock);
 
-				Date last_update;
+			b8 end = i >= type->asset_count;
 
-				if (file_date(FilepathType_Asset, filepath, NULL, &last_update, NULL)) {
+			if (!end) {
 
-					if (!date_equals(last_update, asset->last_file_update)) {
-						
-						asset->last_file_update = last_update;
+				AssetHeader* asset = (AssetHeader*)(type->asset_memory + (i * (sizeof(AssetHeader) + type->asset_size)));
+				from_file = (asset->flags & flags) == flags;
 
-						if (type->reload_file_fn(asset + 1, filepath)) {
-							SV_LOG_INFO("Asset '%s' reloaded from file '%s'\n", type->name, filepath);
-						}
-						else {
-							SV_LOG_ERROR("Asset '%s' can't be reloaded from file '%s'\n", type->name, filepath);
-						}
-					}
+				if (from_file) {
+					string_copy(filepath, asset->text, FILE_PATH_SIZE);
+					last_file_update = asset->last_file_update;
 				}
 			}
+
+			rwlock_read_unlock(&type->lock);
+
+			if (end)
+				break;
+
+			Date last_update;
+
+			if (from_file && file_date(FilepathType_Asset, filepath, NULL, &last_update, NULL) && !date_equals(last_update, last_file_update)) {
+
+				Asset asset = asset_handle(i, type);
+
+				rwlock_write_lock(&type->lock);
+				asset_decompose_ptr(asset)->last_file_update = last_update;
+				rwlock_write_unlock(&type->lock);
+
+				reload_asset(type, asset);
+			}
 		}
 	}
 }
@@ -416,12 +461,19 @@ void asset_free_unused()
 
 		AssetType* type = sys->types + i;
 
+		rwlock_write_lock(&type->lock);
+
 		foreach(i, type->asset_count) {
 
 			AssetHeader* asset = (AssetHeader*)(type->asset_memory + (i * (sizeof(AssetHeader) + type->asset_size)));
 
 			if (asset->flags & AssetFlag_Valid && asset->reference_counter == 0) {
 
+				if (asset->flags & AssetFlag_Failed) {
+					free_asset(asset_handle(i, type));
+					continue;
+				}
+
 				type->free_fn(asset + 1);
 
 				if (asset->flags & AssetFlag_FromFile) {
@@ -434,6 +486,8 @@ void asset_free_unused()
 				free_asset(asset_handle(i, type));
 			}
 		}
+
+		rwlock_write_unlock(&type->lock);
 	}
 }
 
@@ -500,13 +554,43 @@ b8 asset_register_type(const AssetTypeDesc* desc)
 	type->free_fn = desc->free_fn;
 	type->unused_time = desc->unused_time;
 
-	foreach(i, ASSET_TABLE_SIZE) {
-		type->asset_table[i] = u32_max;
-	}
+	type->asset_table = hashmap_init(u32);
 
 	return TRUE;
 }
 
+// Returns FALSE if the load failed, the reference of the caller is kept
+static b8 wait_asset_loading(AssetType* type, Asset asset_handle)
+{
+	b8 loading = TRUE;
+	u32 flags = 0u;
+
+	fast_mutex_lock(&type->loading_mutex);
+
+	while (loading) {
+
+		rwlock_read_lock(&type->lock);
+		flags = asset_decompose_ptr(asset_handle)->flags;
+		rwlock_read_unlock(&type->lock);
+
+		loading = (flags & AssetFlag_Loading) != 0;
+
+		if (loading)
+			condvar_wait(&type->loading_cv, &type->loading_mutex);
+	}
+
+	fast_mutex_unlock(&type->loading_mutex);
+
+	return !(flags & AssetFlag_Failed);
+}
+
+static void notify_asset_loaded(AssetType* type)
+{
+	fast_mutex_lock(&type->loading_mutex);
+	condvar_broadcast(&type->loading_cv);
+	fast_mutex_unlock(&type->loading_mutex);
+}
+
 Asset asset_load_from_file(const char* filepath, AssetPriority priority)
 {
 	AssetType* type = find_asset_type_from_filepath(filepath);
@@ -518,38 +602,105 @@ Asset asset_load_from_file(const char* filepath, AssetPriority priority)
 
 	u64 hash = compute_asset_filepath_hash(filepath);
 
+	rwlock_read_lock(&type->lock);
+
 	Asset asset_handle = find_asset_in_table(type, hash);
+	u32 flags = 0u;
 
 	if (asset_handle) {
+		// The handle comes from the table of the type. Other loaders touch it under the same read lock
+		AssetHeader* asset = asset_type_ptr(type, asset_handle);
+		asset_increment(asset_handle);
+		atomic_store_f64(&asset->last_update, timer_now(), MemoryOrder_Relaxed);
+		flags = asset->flags;
+	}
+
+	rwlock_read_unlock(&type->lock);
+
+	b8 loaded = asset_handle != 0;
+
+	if (!loaded) {
+
+		rwlock_write_lock(&type->lock);
+
+		// Another thread can load the same file between the locks
+		asset_handle = find_asset_in_table(type, hash);
+		loaded = asset_handle != 0;
+
+		if (!loaded)
+			asset_handle = allocate_asset(type, hash);
+
+		// Referenced before releasing the lock, the unused assets can't free it while loading
 		asset_increment(asset_handle);
 
 		AssetHeader* asset = asset_decompose_ptr(asset_handle);
-		if (asset)
-			asset->last_update = timer_now();
-		return asset_handle;
+		asset->last_update = timer_now();
+		flags = asset->flags;
+
+		rwlock_write_unlock(&type->lock);
 	}
-	else {
 
-		asset_handle = allocate_asset(type, hash);
+	if (loaded) {
 
-		u32 asset_index;
-		asset_decompose(asset_handle, &asset_index, NULL);
+		// Loaded by another thread
+		if ((flags & AssetFlag_Loading) && !wait_asset_loading(type, asset_handle)) {
+			asset_decrement(asset_handle);
+			return 0;
+		}
+
+		return asset_handle;
+	}
+	else {
 
-		AssetHeader* asset = (AssetHeader*)(type->asset_memory + (asset_index * (sizeof(AssetHeader) + type->asset_size)));
+		// The asset memory can grow while loading, so the asset is loaded in a temporal buffer
+		void* data = memory_allocate(type->asset_size);
 		
 		// Init asset
-		if (!type->load_file_fn(asset + 1, filepath)) {
+		if (!type->load_file_fn(data, filepath)) {
 
 			SV_LOG_ERROR("Can't load the asset '%s' from '%s'\n", type->name, filepath);
-			free_asset(asset_handle);
+			memory_free(data);
+
+			rwlock_write_lock(&type->lock);
+
+			AssetHeader* asset = asset_decompose_ptr(asset_handle);
+			asset_decrement(asset_handle);
+
+			// The waiting loaders keep a reference, it's freed once they release it
+			if (asset->reference_counter == 0) {
+				free_asset(asset_handle);
+			}
+			else {
+				remove_asset_in_table(type, hash);
+				asset->flags = (asset->flags & ~AssetFlag_Loading) | AssetFlag_Failed;
+			}
+
+			rwlock_write_unlock(&type->lock);
+
+			notify_asset_loaded(type);
 			return 0;
 		}
 
-		asset->flags |= AssetFlag_FromFile;
+		rwlock_write_lock(&type->lock);
+
+		AssetHeader* asset = asset_decompose_ptr(asset_handle);
+		memory_copy(asset + 1, data, type->asset_size);
+		asset->flags = (asset->flags & ~AssetFlag_Loading) | AssetFlag_FromFile;
 		string_copy(asset->text, filepath, FILE_PATH_SIZE);
-		asset_increment(asset_handle);
 
-		file_date(FilepathType_Asset, filepath, NULL, &asset->last_file_update, NULL);
+		if (!sys->watcher && sys->hot_reloading)
+			file_date(FilepathType_Asset, filepath, NULL, &asset->last_file_update, NULL);
+
+		rwlock_write_unlock(&type->lock);
+
+		notify_asset_loaded(type);
+
+		memory_free(data);
+
+		if (sys->watcher) {
+			if (!file_watcher_add(sys->watcher, FilepathType_Asset, filepath))
+				SV_LOG_WARNING("The file '%s' can't be hot reloaded\n", filepath);
+		}
 
 		SV_LOG_INFO("Asset '%s' loaded from '%s'\n", type->name, filepath);
 
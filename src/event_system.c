@@ -1,8 +1,6 @@
 #include "Hosebase/event_system.h"
 
-#include "Hosebase/memory_manager.h"
-
-#define EVENT_TABLE_SIZE 1000
+#include "Hosebase/allocators.h"
 
 typedef struct {
 	EventFn fn;
@@ -13,12 +11,11 @@ typedef struct {
 	char name[NAME_SIZE];
 	EventRegister registers[400];
 	u32 register_count;
-	HashTableEntry entry;
 } EventType;
 
 typedef struct {
 
-	EventType event_table[EVENT_TABLE_SIZE];
+	HashMap(EventType*) event_table; // The types are allocated apart, the callbacks can register while dispatching
 
 } EventSystem;
 
@@ -26,7 +23,28 @@ static EventSystem* event_system;
 
 static EventType* _event_type_get(u64 hash, b8 create, b8* created)
 {
-	return hashtable_get(hash, event_system->event_table, sizeof(EventType), EVENT_TABLE_SIZE, create, created);
+	if (created != NULL)
+		*created = FALSE;
+
+	if (!create)
+	{
+		EventType** type = (EventType**)hashmap_get(&event_system->event_table, hash);
+		return (type != NULL) ? *type : NULL;
+	}
+
+	b8 new_type;
+	EventType** type = (EventType**)hashmap_insert(&event_system->event_table, hash, &new_type);
+
+	if (type == NULL)
+		return NULL;
+
+	if (new_type)
+		*type = memory_allocate(sizeof(EventType));
+
+	if (created != NULL)
+		*created = new_type;
+
+	return *type;
 }
 
 u64 event_compute_handle(const char* system_name, u64 handle)
@@ -87,6 +105,7 @@ void event_dispatch(u64 handle, const char* name, void* data)
 b8 _event_initialize()
 {
 	event_system = memory_allocate(sizeof(EventSystem));
+	event_system->event_table = hashmap_init(EventType*);
 	return TRUE;
 }
 
@@ -94,7 +113,14 @@ void _event_close()
 {
 	if (event_system != NULL)
 	{
-		hashtable_free(event_system->event_table, sizeof(EventType), EVENT_TABLE_SIZE);
+		HashMapIterator it = { 0 };
+
+		while (hashmap_iterator_next(&event_system->event_table, &it))
+		{
+			memory_free(*(EventType**)it.value);
+		}
+
+		hashmap_close(&event_system->event_table);
 
 		memory_free(event_system);
 	}
@@ -45,12 +45,11 @@ SV_INLINE b8 glyph_less_than(const TempGlyph* g0, const TempGlyph* g1)
 
 b8 font_create(Font* font, const char* filepath, f32 pixel_height, FontFlags flags)
 {
-	u8* file_data;
-	u32 file_size;
-	SV_CHECK(file_read_binary(FilepathType_Asset, filepath, &file_data, &file_size));
+	FileView file;
+	SV_CHECK(file_map(FilepathType_Asset, filepath, &file));
 
 	stbtt_fontinfo info;
-	stbtt_InitFont(&info, file_data, 0);
+	stbtt_InitFont(&info, file.data, 0);
 
 	font->glyphs = (Glyph*)memory_allocate(sizeof(Glyph) * FONT_CHAR_COUNT);
 		
@@ -251,7 +250,7 @@ b8 font_create(Font* font, const char* filepath, f32 pixel_height, FontFlags fla
 	font->pixel_height = pixel_height;
 
 	memory_free(atlas);
-	if (file_data) memory_free(file_data);
+	file_unmap(&file);
 
 	return TRUE;
 }
@@ -164,14 +164,6 @@ b8 _graphics_initialize(const GraphicsInitializeDesc *desc)
 	else
 		SV_LOG_INFO("Vulkan device initialized successfuly\n");
 
-	gfx->device.buffer_mutex = mutex_create();
-	gfx->device.image_mutex = mutex_create();
-	gfx->device.sampler_mutex = mutex_create();
-	gfx->device.shader_mutex = mutex_create();
-	gfx->device.render_pass_mutex = mutex_create();
-	gfx->device.depth_stencil_state_mutex = mutex_create();
-	gfx->device.blend_state_mutex = mutex_create();
-
 	gfx->primitives_to_destroy_mutex = mutex_create();
 
 	gfx->primitives_to_destroy = array_init(GraphicsPrimitive *, 2.f);
@@ -336,107 +328,92 @@ void _graphics_close()
 
 	destroy_primitives();
 
-	mutex_lock(gfx->device.buffer_mutex);
-	mutex_lock(gfx->device.image_mutex);
-	mutex_lock(gfx->device.sampler_mutex);
-	mutex_lock(gfx->device.shader_mutex);
-	mutex_lock(gfx->device.render_pass_mutex);
-	mutex_lock(gfx->device.blend_state_mutex);
-	mutex_lock(gfx->device.depth_stencil_state_mutex);
-
 	u32 count;
 
-	count = instance_allocator_size(&gfx->device.buffer_allocator);
+	count = shared_instance_allocator_size(&gfx->device.buffer_allocator);
 	if (count)
 	{
 		SV_LOG_WARNING("There are %u unfreed buffers\n", count);
 
-		foreach_instance(it, &gfx->device.buffer_allocator)
+		foreach_instance(it, &gfx->device.buffer_allocator.allocator)
 		{
 			destroy_unused_primitive((GraphicsPrimitive *)it.ptr);
 		}
 	}
 
-	count = instance_allocator_size(&gfx->device.image_allocator);
+	count = shared_instance_allocator_size(&gfx->device.image_allocator);
 	if (count)
 	{
 		SV_LOG_WARNING("There are %u unfreed images\n", count);
 
-		foreach_instance(it, &gfx->device.image_allocator)
+		foreach_instance(it, &gfx->device.image_allocator.allocator)
 		{
 			destroy_unused_primitive((GraphicsPrimitive *)it.ptr);
 		}
 	}
 
-	count = instance_allocator_size(&gfx->device.sampler_allocator);
+	count = shared_instance_allocator_size(&gfx->device.sampler_allocator);
 	if (count)
 	{
 		SV_LOG_WARNING("There are %u unfreed samplers\n", count);
 
-		foreach_instance(it, &gfx->device.sampler_allocator)
+		foreach_instance(it, &gfx->device.sampler_allocator.allocator)
 		{
 			destroy_unused_primitive((GraphicsPrimitive *)it.ptr);
 		}
 	}
 
-	count = instance_allocator_size(&gfx->device.shader_allocator);
+	count = shared_instance_allocator_size(&gfx->device.shader_allocator);
 	if (count)
 	{
 		SV_LOG_WARNING("There are %u unfreed shaders\n", count);
 
-		foreach_instance(it, &gfx->device.shader_allocator)
+		foreach_instance(it, &gfx->device.shader_allocator.allocator)
 		{
 			destroy_unused_primitive((GraphicsPrimitive *)it.ptr);
 		}
 	}
 
-	count = instance_allocator_size(&gfx->device.render_pass_allocator);
+	count = shared_instance_allocator_size(&gfx->device.render_pass_allocator);
 	if (count)
 	{
 		SV_LOG_WARNING("There are %u unfreed render passes\n", count);
 
-		foreach_instance(it, &gfx->device.render_pass_allocator)
+		foreach_instance(it, &gfx->device.render_pass_allocator.allocator)
 		{
 			destroy_unused_primitive((GraphicsPrimitive *)it.ptr);
 		}
 	}
 
-	count = instance_allocator_size(&gfx->device.blend_state_allocator);
+	count = shared_instance_allocator_size(&gfx->device.blend_state_allocator);
 	if (count)
 	{
 		SV_LOG_WARNING("There are %u unfreed blend states\n", count);
 
-		foreach_instance(it, &gfx->device.blend_state_allocator)
+		foreach_instance(it, &gfx->device.blend_state_allocator.allocator)
 		{
 			destroy_unused_primitive((GraphicsPrimitive *)it.ptr);
 		}
 	}
 
-	count = instance_allocator_size(&gfx->device.depth_stencil_state_allocator);
+	count = shared_instance_allocator_size(&gfx->device.depth_stencil_state_allocator);
 	if (count)
 	{
 		SV_LOG_WARNING("There are %u unfreed depth stencil states\n", count);
 
-		foreach_instance(it, &gfx->device.depth_stencil_state_allocator)
+		foreach_instance(it, &gfx->device.depth_stencil_state_allocator.allocator)
 		{
 			destroy_unused_primitive((GraphicsPrimitive *)it.ptr);
 		}
 	}
 
-	instance_allocator_close(&gfx->device.buffer_allocator);
-	instance_allocator_close(&gfx->device.image_allocator);
-	instance_allocator_close(&gfx->device.sampler_allocator);
-	instance_allocator_close(&gfx->device.shader_allocator);
-	instance_allocator_close(&gfx->device.blend_state_allocator);
-	instance_allocator_close(&gfx->device.depth_stencil_state_allocator);
-
-	mutex_unlock(gfx->device.buffer_mutex);
-	mutex_unlock(gfx->device.image_mutex);
-	mutex_unlock(gfx->device.sampler_mutex);
-	mutex_unlock(gfx->device.shader_mutex);
-	mutex_unlock(gfx->device.render_pass_mutex);
-	mutex_unlock(gfx->device.blend_state_mutex);
-	mutex_unlock(gfx->device.depth_stencil_state_mutex);
+	shared_instance_allocator_close(&gfx->device.buffer_allocator);
+	shared_instance_allocator_close(&gfx->device.image_allocator);
+	shared_instance_allocator_close(&gfx->device.sampler_allocator);
+	shared_instance_allocator_close(&gfx->device.shader_allocator);
+	shared_instance_allocator_close(&gfx->device.render_pass_allocator);
+	shared_instance_allocator_close(&gfx->device.blend_state_allocator);
+	shared_instance_allocator_close(&gfx->device.depth_stencil_state_allocator);
 
 	gfx->device.close();
 
@@ -444,14 +421,6 @@ void _graphics_close()
 	shader_compiler_close();
 #endif SV_SHADER_COMPILER
 
-	mutex_destroy(gfx->device.buffer_mutex);
-	mutex_destroy(gfx->device.image_mutex);
-	mutex_destroy(gfx->device.sampler_mutex);
-	mutex_destroy(gfx->device.shader_mutex);
-	mutex_destroy(gfx->device.render_pass_mutex);
-	mutex_destroy(gfx->device.depth_stencil_state_mutex);
-	mutex_destroy(gfx->device.blend_state_mutex);
-
 	mutex_destroy(gfx->primitives_to_destroy_mutex);
 
 	array_close(&gfx->primitives_to_destroy);
@@ -473,51 +442,37 @@ SV_INLINE void destroy_graphics_primitive(GraphicsPrimitive *p)
 	{
 	case GraphicsPrimitiveType_Image:
 	{
-		mutex_lock(gfx->device.image_mutex);
-		instance_allocator_destroy(&gfx->device.image_allocator, p);
-		mutex_unlock(gfx->device.image_mutex);
+		shared_instance_allocator_destroy(&gfx->device.image_allocator, p);
 		break;
 	}
 	case GraphicsPrimitiveType_Sampler:
 	{
-		mutex_lock(gfx->device.sampler_mutex);
-		instance_allocator_destroy(&gfx->device.sampler_allocator, p);
-		mutex_unlock(gfx->device.sampler_mutex);
+		shared_instance_allocator_destroy(&gfx->device.sampler_allocator, p);
 		break;
 	}
 	case GraphicsPrimitiveType_Buffer:
 	{
-		mutex_lock(gfx->device.buffer_mutex);
-		instance_allocator_destroy(&gfx->device.buffer_allocator, p);
-		mutex_unlock(gfx->device.buffer_mutex);
+		shared_instance_allocator_destroy(&gfx->device.buffer_allocator, p);
 		break;
 	}
 	case GraphicsPrimitiveType_Shader:
 	{
-		mutex_lock(gfx->device.shader_mutex);
-		instance_allocator_destroy(&gfx->device.shader_allocator, p);
-		mutex_unlock(gfx->device.shader_mutex);
+		shared_instance_allocator_destroy(&gfx->device.shader_allocator, p);
 		break;
 	}
 	case GraphicsPrimitiveType_RenderPass:
 	{
-		mutex_lock(gfx->device.render_pass_mutex);
-		instance_allocator_destroy(&gfx->device.render_pass_allocator, p);
-		mutex_unlock(gfx->device.render_pass_mutex);
+		shared_instance_allocator_destroy(&gfx->device.render_pass_allocator, p);
 		break;
 	}
 	case GraphicsPrimitiveType_BlendState:
 	{
-		mutex_lock(gfx->device.blend_state_mutex);
-		instance_allocator_destroy(&gfx->device.blend_state_allocator, p);
-		mutex_unlock(gfx->device.blend_state_mutex);
+		shared_instance_allocator_destroy(&gfx->device.blend_state_allocator, p);
 		break;
 	}
 	case GraphicsPrimitiveType_DepthStencilState:
 	{
-		mutex_lock(gfx->device.depth_stencil_state_mutex);
-		instance_allocator_destroy(&gfx->device.depth_stencil_state_allocator, p);
-		mutex_unlock(gfx->device.depth_stencil_state_mutex);
+		shared_instance_allocator_destroy(&gfx->device.depth_stencil_state_allocator, p);
 		break;
 	}
 	}
@@ -784,9 +739,7 @@ b8 graphics_buffer_create(GPUBuffer **buffer, const GPUBufferDesc *desc)
 
 	// Allocate memory
 	{
-		mutex_lock(gfx->device.buffer_mutex);
-		*buffer = (GPUBuffer *)instance_allocator_create(&gfx->device.buffer_allocator);
-		mutex_unlock(gfx->device.buffer_mutex);
+		*buffer = (GPUBuffer *)shared_instance_allocator_create(&gfx->device.buffer_allocator);
 	}
 	// Create API primitive
 	// TODO: Handle error
@@ -812,9 +765,7 @@ b8 graphics_shader_create(Shader **shader, const ShaderDesc *desc)
 
 	// Allocate memory
 	{
-		mutex_lock(gfx->device.shader_mutex);
-		*shader = (Shader *)instance_allocator_create(&gfx->device.shader_allocator);
-		mutex_unlock(gfx->device.shader_mutex);
+		*shader = (Shader *)shared_instance_allocator_create(&gfx->device.shader_allocator);
 	}
 
 	// Create API primitive
@@ -836,9 +787,7 @@ b8 graphics_image_create(GPUImage **image, const GPUImageDesc *desc)
 
 	// Allocate memory
 	{
-		mutex_lock(gfx->device.image_mutex);
-		*image = (GPUImage *)instance_allocator_create(&gfx->device.image_allocator);
-		mutex_unlock(gfx->device.image_mutex);
+		*image = (GPUImage *)shared_instance_allocator_create(&gfx->device.image_allocator);
 	}
 
 	// Create API primitive
@@ -863,9 +812,7 @@ b8 graphics_sampler_create(Sampler **sampler, const SamplerDesc *desc)
 
 	// Allocate memory
 	{
-		mutex_lock(gfx->device.sampler_mutex);
-		*sampler = (Sampler *)instance_allocator_create(&gfx->device.sampler_allocator);
-		mutex_unlock(gfx->device.sampler_mutex);
+		*sampler = (Sampler *)shared_instance_allocator_create(&gfx->device.sampler_allocator);
 	}
 
 	// Create API primitive
@@ -886,9 +833,7 @@ b8 graphics_renderpass_create(RenderPass **renderPass, const RenderPassDesc *des
 
 	// Allocate memory
 	{
-		mutex_lock(gfx->device.render_pass_mutex);
-		*renderPass = (RenderPass *)instance_allocator_create(&gfx->device.render_pass_allocator);
-		mutex_unlock(gfx->device.render_pass_mutex);
+		*renderPass = (RenderPass *)shared_instance_allocator_create(&gfx->device.render_pass_allocator);
 	}
 
 	// Create API primitive
@@ -926,9 +871,7 @@ b8 graphics_blendstate_create(BlendState **blendState, const BlendStateDesc *des
 
 	// Allocate memory
 	{
-		mutex_lock(gfx->device.blend_state_mutex);
-		*blendState = (BlendState *)instance_allocator_create(&gfx->device.blend_state_allocator);
-		mutex_unlock(gfx->device.blend_state_mutex);
+		*blendState = (BlendState *)shared_instance_allocator_create(&gfx->device.blend_state_allocator);
 	}
 
 	// Create API primitive
@@ -957,9 +900,7 @@ b8 graphics_depthstencilstate_create(DepthStencilState **depthStencilState, cons
 
 	// Allocate memory
 	{
-		mutex_lock(gfx->device.depth_stencil_state_mutex);
-		*depthStencilState = (DepthStencilState *)instance_allocator_create(&gfx->device.depth_stencil_state_allocator);
-		mutex_unlock(gfx->device.depth_stencil_state_mutex);
+		*depthStencilState = (DepthStencilState *)shared_instance_allocator_create(&gfx->device.depth_stencil_state_allocator);
 	}
 
 	// Create API primitive
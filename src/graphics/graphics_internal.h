@@ -261,27 +261,19 @@ typedef struct {
 	FNP_graphics_api_event_mark	event_mark;
 	FNP_graphics_api_event_end	event_end;
 
-	// TODO
-	InstanceAllocator buffer_allocator;
-	Mutex			  buffer_mutex;
+	SharedInstanceAllocator buffer_allocator;
 
-	InstanceAllocator image_allocator;
-	Mutex             image_mutex;
+	SharedInstanceAllocator image_allocator;
 
-	InstanceAllocator sampler_allocator;
-	Mutex             sampler_mutex;
+	SharedInstanceAllocator sampler_allocator;
 
-	InstanceAllocator shader_allocator;
-	Mutex             shader_mutex;
+	SharedInstanceAllocator shader_allocator;
 
-	InstanceAllocator render_pass_allocator;
-	Mutex             render_pass_mutex;
+	SharedInstanceAllocator render_pass_allocator;
 
-	InstanceAllocator blend_state_allocator;
-	Mutex             blend_state_mutex;
+	SharedInstanceAllocator blend_state_allocator;
 
-	InstanceAllocator depth_stencil_state_allocator;
-	Mutex             depth_stencil_state_mutex;
+	SharedInstanceAllocator depth_stencil_state_allocator;
 
 	GraphicsAPI api;
 
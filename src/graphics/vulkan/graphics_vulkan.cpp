@@ -360,13 +360,13 @@ void graphics_vulkan_device_prepare(GraphicsDevice* device_)
 	device.event_mark			= sv::graphics_vulkan_event_mark;
 	device.event_end			= sv::graphics_vulkan_event_end;
 
-	device.buffer_allocator              = instance_allocator_init(sizeof(sv::Buffer_vk), 200u);
-	device.image_allocator			     = instance_allocator_init(sizeof(sv::Image_vk), 200u);
-	device.sampler_allocator			 = instance_allocator_init(sizeof(sv::Sampler_vk), 200u);
-	device.shader_allocator			     = instance_allocator_init(sizeof(sv::Shader_vk), 200u);
-	device.render_pass_allocator		 = instance_allocator_init(sizeof(sv::RenderPass_vk), 200u);
-	device.blend_state_allocator		 = instance_allocator_init(sizeof(sv::BlendState_vk), 200u);
-	device.depth_stencil_state_allocator = instance_allocator_init(sizeof(sv::DepthStencilState_vk), 200u);
+	device.buffer_allocator              = shared_instance_allocator_init(sizeof(sv::Buffer_vk), 200u);
+	device.image_allocator			     = shared_instance_allocator_init(sizeof(sv::Image_vk), 200u);
+	device.sampler_allocator			 = shared_instance_allocator_init(sizeof(sv::Sampler_vk), 200u);
+	device.shader_allocator			     = shared_instance_allocator_init(sizeof(sv::Shader_vk), 200u);
+	device.render_pass_allocator		 = shared_instance_allocator_init(sizeof(sv::RenderPass_vk), 200u);
+	device.blend_state_allocator		 = shared_instance_allocator_init(sizeof(sv::BlendState_vk), 200u);
+	device.depth_stencil_state_allocator = shared_instance_allocator_init(sizeof(sv::DepthStencilState_vk), 200u);
 		
 	device.api = GraphicsAPI_Vulkan;
 }
@@ -378,7 +378,6 @@ namespace sv {
 		g_API = std::make_unique<Graphics_vk>();
 		
 		g_API->mutexCMD = mutex_create();
-		g_API->pipeline_mutex = mutex_create();
 		g_API->IDMutex = mutex_create();
 
 		// Instance extensions and validation layers
@@ -759,7 +758,6 @@ namespace sv {
 		vkDeviceWaitIdle(g_API->device);
 
 		mutex_destroy(g_API->mutexCMD);
-		mutex_destroy(g_API->pipeline_mutex);
 		mutex_destroy(g_API->IDMutex);
 
 		// Destroy swapchain
@@ -976,6 +974,18 @@ namespace sv {
 		return g_API->activeCMDCount;
     }
 
+	// Must be called with the render pass lock
+	static VkFramebuffer graphics_vulkan_framebuffer_find(RenderPass_vk& renderPass, u64 hash)
+	{
+		for (auto it = renderPass.frameBuffers.begin(); it != renderPass.frameBuffers.end(); ++it) {
+
+			if (it->first == hash)
+				return it->second;
+		}
+
+		return VK_NULL_HANDLE;
+	}
+
     void graphics_vulkan_renderpass_begin(CommandList cmd_)
     {
 		GraphicsState& state = graphics_state_get()->graphics[cmd_];
@@ -996,51 +1006,54 @@ namespace sv {
 			}
 
 			// Find framebuffer
-			SV_LOCK_GUARD(renderPass.mutex, lock);
-
-			for (auto it = renderPass.frameBuffers.begin(); it != renderPass.frameBuffers.end(); ++it) {
-
-				if (it->first == hash) {
-					fb = it->second;
-					break;
-				}
+			{
+				SV_READ_GUARD(renderPass.lock, lock);
+				fb = graphics_vulkan_framebuffer_find(renderPass, hash);
 			}
-			
+
 			if (fb == VK_NULL_HANDLE) {
 
-				// Create attachments views list
-				VkImageView views[GraphicsLimit_Attachment];
-				u32 width = 0, height = 0, layers = 0;
+				SV_WRITE_GUARD(renderPass.lock, lock);
 
-				foreach(i, att_count) {
-					Image_vk& att = *reinterpret_cast<Image_vk*>(state.attachments[i]);
+				// Another thread can create it meanwhile
+				fb = graphics_vulkan_framebuffer_find(renderPass, hash);
 
-					if (renderPass.info.depthstencil_attachment_index == i) {
-						views[i] = att.depth_stencil_view;
-					}
-					else {
-						views[i] = att.render_target_view;
-					}
+				if (fb == VK_NULL_HANDLE) {
 
-					if (i == 0) {
-						width = att.info.width;
-						height = att.info.height;
-						layers = att.layers;
-					}
-				}
-				
-				VkFramebufferCreateInfo create_info{};
-				create_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-				create_info.renderPass = renderPass.renderPass;
-				create_info.attachmentCount = att_count;
-				create_info.pAttachments = views;
-				create_info.width = width;
-				create_info.height = height;
-				create_info.layers = layers;
+					// Create attachments views list
+					VkImageView views[GraphicsLimit_Attachment];
+					u32 width = 0, height = 0, layers = 0;
+
+					foreach(i, att_count) {
+						Image_vk& att = *reinterpret_cast<Image_vk*>(state.attachments[i]);
 
-				vkAssert(vkCreateFramebuffer(g_API->device, &create_info, nullptr, &fb));
+						if (renderPass.info.depthstencil_attachment_index == i) {
+							views[i] = att.depth_stencil_view;
+						}
+						else {
+							views[i] = att.render_target_view;
+						}
 
-				renderPass.frameBuffers.push_back({ hash, fb });
+						if (i == 0) {
+							width = att.info.width;
+							height = att.info.height;
+							layers = att.layers;
+						}
+					}
+				
+					VkFramebufferCreateInfo create_info{};
+					create_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+					create_info.renderPass = renderPass.renderPass;
+					create_info.attachmentCount = att_count;
+					create_info.pAttachments = views;
+					create_info.width = width;
+					create_info.height = height;
+					create_info.layers = layers;
+
+					vkAssert(vkCreateFramebuffer(g_API->device, &create_info, nullptr, &fb));
+
+					renderPass.frameBuffers.push_back({ hash, fb });
+				}
 			}
 		}	
 
@@ -1832,8 +1845,15 @@ namespace sv {
 			// Find Pipeline
 			VulkanPipeline* pipelinePtr = nullptr;
 			{
+				SV_READ_GUARD(g_API->pipeline_lock, lock);
+				auto it = g_API->pipelines.find(pipelineHash);
+				if (it != g_API->pipelines.end())
+					pipelinePtr = &it->second;
+			}
+			if (pipelinePtr == nullptr) {
+
 				// Critical Section
-				SV_LOCK_GUARD(g_API->pipeline_mutex, lock);
+				SV_WRITE_GUARD(g_API->pipeline_lock, lock);
 				auto it = g_API->pipelines.find(pipelineHash);
 				if (it == g_API->pipelines.end()) {
 					
@@ -3010,8 +3030,6 @@ namespace sv {
 		bool hasDepthStencil = false;
 		u32 colorIt = 0u;
 
-		renderPass.mutex = mutex_create();
-
 		for (u32 i = 0; i < desc.attachment_count; ++i) {
 			const AttachmentDesc& attDesc = desc.attachments[i];
 
@@ -3135,8 +3153,6 @@ namespace sv {
 
     bool graphics_vulkan_renderpass_destroy(RenderPass_vk& renderPass)
     {
-		mutex_destroy(renderPass.mutex);
-	
 		vkDestroyRenderPass(g_API->device, renderPass.renderPass, nullptr);
 		for (auto& it : renderPass.frameBuffers) {
 			vkDestroyFramebuffer(g_API->device, it.second, nullptr);
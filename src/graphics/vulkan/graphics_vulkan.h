@@ -187,7 +187,7 @@ namespace sv {
 				return *this;
 			}
 
-		Mutex mutex;
+		RWLock lock = {};
 		Mutex creationMutex;
 
 		VkPipelineLayout	             layout = VK_NULL_HANDLE;
@@ -248,7 +248,7 @@ namespace sv {
 		VkRenderPass				renderPass;
 		std::vector<std::pair<u64, VkFramebuffer>>	frameBuffers;
 		VkRenderPassBeginInfo			beginInfo;
-		Mutex					mutex;
+		RWLock					lock = {};
     };
     
     // BlendState
@@ -351,7 +351,7 @@ namespace sv {
 
 		// TODO
 		std::unordered_map<u64, VulkanPipeline>        pipelines;
-		Mutex			                               pipeline_mutex;
+		RWLock			                               pipeline_lock = {};
 
 		u64 IDCount = 0u;
 		Mutex IDMutex;
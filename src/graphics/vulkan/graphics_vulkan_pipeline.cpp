@@ -64,7 +64,6 @@ namespace sv
 	{
 		Graphics_vk &gfx = graphics_vulkan_device_get();
 
-		p.mutex = mutex_create();
 		p.creationMutex = mutex_create();
 
 		// Create
@@ -113,7 +112,6 @@ namespace sv
 	{
 		Graphics_vk &gfx = graphics_vulkan_device_get();
 
-		mutex_destroy(pipeline.mutex);
 		mutex_destroy(pipeline.creationMutex);
 
 		vkDestroyPipelineLayout(gfx.device, pipeline.layout, nullptr);
@@ -133,8 +131,21 @@ namespace sv
 
 		hash = hash_combine(hash, (u64)renderPass.renderPass);
 
-		SV_LOCK_GUARD(pipeline.mutex, lock);
+		// Almost every call finds the pipeline, the readers don't block each other
+		{
+			SV_READ_GUARD(pipeline.lock, lock);
+
+			auto it = pipeline.pipelines.find(hash);
+			if (it != pipeline.pipelines.end())
+			{
+				atomic_store_f64(&pipeline.lastUsage, timer_now(), MemoryOrder_Relaxed);
+				return it->second;
+			}
+		}
+
+		SV_WRITE_GUARD(pipeline.lock, lock);
 
+		// Another thread can create it meanwhile
 		auto it = pipeline.pipelines.find(hash);
 		if (it == pipeline.pipelines.end())
 		{
@@ -1,4 +1,7 @@
 #include "Hosebase/imgui.h"
+
+#if SV_GRAPHICS
+
 #include "Hosebase/input.h"
 #include "Hosebase/platform.h"
 #include "Hosebase/render_utils.h"
@@ -60,6 +63,7 @@ typedef struct
 
 	GuiParent parents[PARENTS_MAX];
 	u32 parent_count;
+	HashMap(u32) parent_table; // Parent id to index, reset every frame
 
 	GuiParent root;
 
@@ -92,6 +96,7 @@ typedef struct
 
 	GuiLayoutRegister layout_registers[100];
 	u32 layout_register_count;
+	HashMap(u32) layout_table; // Name hash to layout index
 
 	struct
 	{
@@ -101,6 +106,7 @@ typedef struct
 	GuiParentState *parent_states;
 	u32 parent_state_count;
 	u32 parent_state_capacity;
+	HashMap(u32) parent_state_table; // Parent id to state index
 
 	b8 input_used;
 
@@ -126,30 +132,28 @@ u32 gui_parent_state_find(u64 id, b8 create, u8 *created)
 	if (id == 0 || !(id & SV_BIT(0)))
 		return u32_max;
 
-	u32 index = u32_max;
-
-	foreach (i, gui->parent_state_count)
+	if (!create)
 	{
-		if (gui->parent_states[i].id == id)
-		{
-			index = i;
-			break;
-		}
+		u32 *index = (u32 *)hashmap_get(&gui->parent_state_table, id);
+		return (index != NULL) ? *index : u32_max;
 	}
 
-	if (create && index == u32_max)
+	b8 new_state;
+	u32 *index = (u32 *)hashmap_insert(&gui->parent_state_table, id, &new_state);
+
+	if (new_state)
 	{
 		array_prepare(&gui->parent_states, &gui->parent_state_count, &gui->parent_state_capacity, gui->parent_state_capacity + 50, 1, sizeof(GuiParentState));
 
-		index = gui->parent_state_count++;
-		GuiParentState *state = gui->parent_states + index;
+		*index = gui->parent_state_count++;
+		GuiParentState *state = gui->parent_states + *index;
 
 		state->id = id;
 		if (created != NULL)
 			*created = TRUE;
 	}
 
-	return index;
+	return *index;
 }
 
 /////////////////////////////// WIDGET UTILS ///////////////////////////
@@ -230,14 +234,8 @@ static b8 gui_layout_property_read(GuiParent *parent, u32 property, u8 *it, u32
 
 static u32 gui_find_layout_index(const char *name)
 {
-	// TODO: Optimize
-	foreach (i, gui->layout_register_count)
-	{
-
-		if (string_equals(gui->layout_registers[i].name, name))
-			return i;
-	}
-	return u32_max;
+	u32 *index = (u32 *)hashmap_get(&gui->layout_table, hash_string(name));
+	return (index != NULL) ? *index : u32_max;
 }
 
 /////////////////////////// PARENT UTILS //////////////////////////////
@@ -272,7 +270,19 @@ static void gui_parent_add_child(GuiParent *parent, GuiParent *child)
 {
 	child->parent = parent;
 
-	// TODO: Dynamic
+	// The old array stays in the frame allocator until the next frame ends
+	if (parent->child_count == parent->child_capacity)
+	{
+		u32 capacity = SV_MAX(parent->child_capacity * 2, 8);
+		GuiParent **childs = (GuiParent **)frame_allocate(sizeof(GuiParent *) * capacity);
+
+		if (parent->child_count)
+			memory_copy(childs, parent->childs, sizeof(GuiParent *) * parent->child_count);
+
+		parent->childs = childs;
+		parent->child_capacity = capacity;
+	}
+
 	parent->childs[parent->child_count++] = child;
 }
 
@@ -376,6 +386,10 @@ static void adjust_widget_bounds(GuiParent *parent)
 
 static b8 parent_less_than(const GuiParent **p0, const GuiParent **p1)
 {
+	// The sort is not stable, the equal depths keep the creation order
+	if ((*p0)->depth == (*p1)->depth)
+		return *p0 < *p1;
+
 	return (*p0)->depth > (*p1)->depth;
 }
 
@@ -530,6 +544,7 @@ static void free_parents()
 {
 	memory_zero(gui->parents, sizeof(GuiParent) * gui->parent_count);
 	gui->parent_count = 0;
+	hashmap_reset(&gui->parent_table);
 }
 
 //////////////////////////// BUFFER WRITES //////////////////////////////////
@@ -628,6 +643,9 @@ b8 gui_initialize()
 
 	gui->buffer = buffer_init(1.7f);
 	gui->id_stack = array_init(u64, 2.f);
+	gui->parent_table = hashmap_init(u32);
+	gui->layout_table = hashmap_init(u32);
+	gui->parent_state_table = hashmap_init(u32);
 
 	gui->focus.type = u32_max;
 	gui->focus.id = 0;
@@ -648,6 +666,12 @@ void gui_close()
 
 		buffer_close(&gui->buffer);
 		array_close(&gui->id_stack);
+		hashmap_close(&gui->parent_table);
+		hashmap_close(&gui->layout_table);
+		hashmap_close(&gui->parent_state_table);
+
+		if (gui->parent_states != NULL)
+			memory_free(gui->parent_states);
 
 		memory_free(gui);
 	}
@@ -702,7 +726,9 @@ void gui_end()
 		gui->root.depth = 1;
 		gui->root.widget_bounds = gui->root.bounds;
 		gui->root.state = gui_parent_state_find(0x39485763293ULL, TRUE, NULL);
+		gui->root.childs = NULL;
 		gui->root.child_count = 0;
+		gui->root.child_capacity = 0;
 		gui->root.parent = NULL;
 		gui_initialize_layout(&gui->root);
 
@@ -782,6 +808,12 @@ void gui_end()
 				gui_read(it, parent->id);
 				gui_read(it, parent->layout.type);
 
+				// The first parent with the id is the one found
+				b8 parent_created;
+				u32 *parent_index = (u32 *)hashmap_insert(&gui->parent_table, parent->id, &parent_created);
+				if (parent_created)
+					*parent_index = (u32)(parent - gui->parents);
+
 				b8 ignore_layout = FALSE;
 
 				// Initialize state
@@ -1334,6 +1366,10 @@ u32 gui_register_layout(const GuiRegisterLayoutDesc *desc)
 	gui->layout_registers[i].compute_bounds_fn = desc->compute_bounds_fn;
 	gui->layout_registers[i].property_read_fn = desc->property_read_fn;
 
+	u32 *index = (u32 *)hashmap_insert(&gui->layout_table, hash_string(desc->name), NULL);
+	if (index != NULL)
+		*index = i;
+
 	return i;
 }
 
@@ -1514,14 +1550,8 @@ GuiParent *gui_find_parent(u64 parent_id)
 	if (parent_id == 0)
 		return &gui->root;
 
-	foreach (i, gui->parent_count)
-	{
-
-		if (gui->parents[i].id == parent_id)
-			return gui->parents + i;
-	}
-
-	return NULL;
+	u32 *index = (u32 *)hashmap_get(&gui->parent_table, parent_id);
+	return (index != NULL) ? (gui->parents + *index) : NULL;
 }
 
 GuiParent *gui_current_parent()
@@ -1832,3 +1862,5 @@ static void register_default_layouts()
 	desc.property_read_fn = free_layout_property_read;
 	gui->register_ids.layout_free = gui_register_layout(&desc);
 }
+
+#endif
\ No newline at end of file
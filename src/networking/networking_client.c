@@ -39,7 +39,7 @@ inline void _client_message_save(const void *data, u32 size, u32 client_id)
 	ClientData *c = client;
 
 	WebMessage reg;
-	reg.data = memory_allocate(size);
+	reg.data = memory_allocate_uninit(size);
 	memory_copy(reg.data, data, size);
 
 	reg.size = size;
@@ -308,7 +308,7 @@ void web_client_close()
 
 inline b8 _web_client_send(NetMessageCustom msg, const void *data, u32 size, b8 assert)
 {
-	u8 *mem = memory_allocate(sizeof(NetMessageCustom) + size);
+	u8 *mem = memory_allocate_uninit(sizeof(NetMessageCustom) + size);
 
 	memory_copy(mem, &msg, sizeof(NetMessageCustom));
 	memory_copy(mem + sizeof(NetMessageCustom), data, size);
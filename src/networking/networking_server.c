@@ -273,7 +273,7 @@ inline void _server_message_save(NetMessageCustom *header)
 	u32 size = header->header.size + sizeof(NetHeader) - sizeof(NetMessageCustom);
 
 	WebMessage reg;
-	reg.data = memory_allocate(size);
+	reg.data = memory_allocate_uninit(size);
 	memory_copy(reg.data, header + 1, size);
 
 	reg.size = size;
@@ -507,7 +507,7 @@ b8 web_server_send(u32 *clients, u32 client_count, b8 ignore, const void *data,
 
 	// TODO: Use thread stack
 	u32 buffer_size = sizeof(NetHeader) + size;
-	u8 *buffer = memory_allocate(buffer_size);
+	u8 *buffer = memory_allocate_uninit(buffer_size);
 
 	NetHeader header;
 	header.type = HEADER_TYPE_CUSTOM;
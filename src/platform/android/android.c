@@ -9,6 +9,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/sysinfo.h>
+#include <sched.h>
+#include <unwind.h>
+#include <linux/futex.h>
 #include <stdatomic.h>
 #include <dlfcn.h>
 
@@ -275,6 +281,88 @@ b8 file_read_text(FilepathType type, const char *filepath_, u8 **data, u32 *size
     return TRUE;
 }
 
+b8 file_map(FilepathType type, const char *filepath_, FileView *view)
+{
+    char filepath[FILE_PATH_SIZE];
+    filepath_resolve(filepath, filepath_, type);
+
+    memory_zero(view, sizeof(FileView));
+
+    if (type == FilepathType_File)
+    {
+        // The user close() hides the one in unistd.h, the descriptor is taken from the stream
+        FILE *file = fopen(filepath, "rb");
+
+        if (file == NULL)
+        {
+            SV_LOG_ERROR("File '%s' not found\n", filepath);
+            return FALSE;
+        }
+
+        struct stat s;
+
+        if (fstat(fileno(file), &s) != 0 || s.st_size > (off_t)u32_max)
+        {
+            fclose(file);
+            return FALSE;
+        }
+
+        if (s.st_size)
+        {
+            void *data = mmap(NULL, (size_t)s.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+
+            if (data == MAP_FAILED)
+            {
+                fclose(file);
+                return FALSE;
+            }
+
+            view->data = (const u8 *)data;
+            view->size = (u32)s.st_size;
+        }
+
+        fclose(file);
+    }
+    else if (type == FilepathType_Asset)
+    {
+        AAssetManager *assets = android->app->activity->assetManager;
+
+        AAsset *file = AAssetManager_open(assets, filepath, AASSET_MODE_BUFFER);
+
+        if (file == NULL)
+        {
+            SV_LOG_ERROR("Asset file '%s' not found\n", filepath);
+            return FALSE;
+        }
+
+        // Uncompressed assets are mapped from the apk, the buffer lives until the asset is closed
+        view->size = (u32)AAsset_getLength(file);
+        view->data = view->size ? (const u8 *)AAsset_getBuffer(file) : NULL;
+        view->_handle = (u64)file;
+
+        if (view->size && view->data == NULL)
+        {
+            AAsset_close(file);
+            memory_zero(view, sizeof(FileView));
+            return FALSE;
+        }
+    }
+    else
+        return FALSE;
+
+    return TRUE;
+}
+
+void file_unmap(FileView *view)
+{
+    if (view->_handle)
+        AAsset_close((AAsset *)view->_handle);
+    else if (view->data)
+        munmap((void *)view->data, view->size);
+
+    memory_zero(view, sizeof(FileView));
+}
+
 SV_INLINE b8 create_path(const char *filepath)
 {
     char folder[FILE_PATH_SIZE] = "\0";
@@ -446,6 +534,98 @@ void *library_address(Library library, const char *name)
 
 /////////////////////////////// MULTITHREADING ///////////////////////
 
+// unistd.h can't be included, the user close() declared in hosebase.h collides with it
+long syscall(long number, ...);
+
+void os_futex_wait(volatile u32 *address, u32 value)
+{
+    syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+void os_futex_wake(volatile u32 *address, b8 all)
+{
+    syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, all ? i32_max : 1, NULL, NULL, 0);
+}
+
+Thread os_thread_current()
+{
+    return (Thread)pthread_self();
+}
+
+u32 os_processor_count()
+{
+    return (u32)SV_MAX(get_nprocs(), 1);
+}
+
+// Reads a small sysfs file, the path is prefix + n + suffix
+static b8 sysfs_read(char *buffer, u32 size, const char *prefix, u32 n, const char *suffix)
+{
+    char path[FILE_PATH_SIZE];
+    char n_str[30];
+
+    string_copy(path, prefix, FILE_PATH_SIZE);
+    string_from_u32(n_str, n);
+    string_append(path, n_str, FILE_PATH_SIZE);
+    string_append(path, suffix, FILE_PATH_SIZE);
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return FALSE;
+
+    size_t read = fread(buffer, 1, size - 1, file);
+    fclose(file);
+
+    buffer[read] = '\0';
+    return read > 0;
+}
+
+static u32 sysfs_read_u32(const char *prefix, u32 n, const char *suffix, u32 default_value)
+{
+    char buffer[64];
+
+    if (!sysfs_read(buffer, sizeof(buffer), prefix, n, suffix) || buffer[0] < '0' || buffer[0] > '9')
+        return default_value;
+
+    u32 value = 0;
+
+    for (const char *it = buffer; *it >= '0' && *it <= '9'; ++it)
+        value = value * 10 + (u32)(*it - '0');
+
+    return value;
+}
+
+// The phones are not NUMA, the clusters of big.LITTLE are told apart by the capacity
+u32 os_cpu_topology(CpuInfo *cpus, u32 max)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        return 0;
+
+    u32 count = 0;
+
+    for (u32 cpu = 0; cpu < CPU_SETSIZE && count < max; ++cpu)
+    {
+        if (!CPU_ISSET(cpu, &set))
+            continue;
+
+        CpuInfo *info = cpus + count++;
+        info->id = cpu;
+        info->core = cpu; // No SMT
+        info->package = sysfs_read_u32("/sys/devices/system/cpu/cpu", cpu, "/topology/physical_package_id", 0);
+        info->numa_node = 0;
+
+        // Older kernels don't expose the capacity, the maximum frequency orders the clusters as well
+        info->performance = sysfs_read_u32("/sys/devices/system/cpu/cpu", cpu, "/cpu_capacity", 0);
+
+        if (info->performance == 0)
+            info->performance = sysfs_read_u32("/sys/devices/system/cpu/cpu", cpu, "/cpufreq/cpuinfo_max_freq", 0) / 1000;
+    }
+
+    return count;
+}
+
 u32 interlock_increment_u32(volatile u32 *n)
 {
     return __sync_fetch_and_add(n, 1);
@@ -491,16 +671,38 @@ void mutex_unlock(Mutex mutex_)
     pthread_mutex_unlock(mutex);
 }
 
+typedef struct
+{
+    ThreadMainFn fn;
+    void *data;
+} ThreadStart;
+
+static void *thread_start(void *arg)
+{
+    ThreadStart start = *(ThreadStart *)arg;
+    memory_free(arg);
+
+    start.fn(start.data);
+
+    scratch_thread_close();
+    _memory_thread_close();
+    return NULL;
+}
+
 Thread thread_create(ThreadMainFn main, void *data)
 {
     assert_static(sizeof(pthread_t) <= sizeof(Thread));
 
+    ThreadStart *start = memory_allocate(sizeof(ThreadStart));
+    start->fn = main;
+    start->data = data;
+
     pthread_t thread;
-    void *ret;
 
-    if (pthread_create(&thread, NULL, main, "") != 0)
+    if (pthread_create(&thread, NULL, thread_start, start) != 0)
     {
         SV_LOG_ERROR("Can't create a thread\n");
+        memory_free(start);
         return 0;
     }
 
@@ -548,6 +750,43 @@ void thread_sleep(u64 millis)
     } while (res);
 }
 
+typedef struct
+{
+    void **frames;
+    u32 max;
+    u32 count;
+    u32 skip;
+} StackTraceState;
+
+static _Unwind_Reason_Code stack_trace_callback(struct _Unwind_Context *context, void *arg)
+{
+    StackTraceState *state = (StackTraceState *)arg;
+    uintptr_t pc = _Unwind_GetIP(context);
+
+    if (pc == 0 || state->count == state->max)
+        return _URC_END_OF_STACK;
+
+    if (state->skip)
+        state->skip--;
+    else
+        state->frames[state->count++] = (void *)pc;
+
+    return _URC_NO_REASON;
+}
+
+// Bionic has no backtrace(), the unwinder walks the exception tables
+u32 thread_stack_trace(void **frames, u32 max)
+{
+    StackTraceState state;
+    state.frames = frames;
+    state.max = max;
+    state.count = 0;
+    state.skip = 1; // This function
+
+    _Unwind_Backtrace(stack_trace_callback, &state);
+    return state.count;
+}
+
 void thread_yield()
 {
     // TODO: pthread_yield();
@@ -563,6 +802,38 @@ void thread_configure(Thread thread, const char *name, u64 affinity_mask, Thread
 {
 }
 
+b8 thread_set_affinity(Thread thread, const CpuMask *mask)
+{
+    return FALSE;
+}
+
+//////////////////////////////// FILE WATCHER ////////////////////////////
+
+// The assets are packed in the apk, there is nothing to watch
+
+FileWatcher file_watcher_create()
+{
+    return 0;
+}
+
+void file_watcher_destroy(FileWatcher watcher)
+{
+}
+
+b8 file_watcher_add(FileWatcher watcher, FilepathType type, const char *filepath)
+{
+    return FALSE;
+}
+
+void file_watcher_remove(FileWatcher watcher, FilepathType type, const char *filepath)
+{
+}
+
+b8 file_watcher_next(FileWatcher watcher, FilepathType *type, char *filepath)
+{
+    return FALSE;
+}
+
 //////////////////////////////// CLIPBOARD ////////////////////////////
 
 b8 clipboard_write_ansi(const char *text)
@@ -0,0 +1,770 @@
+#if SV_PLATFORM_LINUX
+#define _GNU_SOURCE
+#endif
+
+#include "platform_internal.h"
+
+#if SV_PLATFORM_WINDOWS || SV_PLATFORM_LINUX
+
+#if SV_PLATFORM_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#define FILE_ASYNC_MAX 1024 // Requests in flight
+#define FILE_URING_ENTRIES 256
+#define FILE_URING_CQ_ENTRIES (FILE_ASYNC_MAX * 2 + FILE_URING_ENTRIES) // A read and a cancel per request, plus the stop
+
+#define FILE_URING_STOP 0xFFFFFFFFFFFFFFFFULL
+#define FILE_URING_IGNORE 0xFFFFFFFFFFFFFFFEULL
+
+typedef struct
+{
+
+	FileReadFn callback;
+	void *user_data;
+	TaskContext *context;
+
+	FilepathType type;
+	char filepath[FILE_PATH_SIZE];
+	b8 text;
+
+	u8 *data;
+	u32 size;
+	u32 offset;
+	i32 fd;
+	b8 success;
+
+	volatile u32 cancelled;
+	u32 generation;
+	u32 next_free;
+
+} FileReadRequest;
+
+#if SV_PLATFORM_LINUX
+
+typedef struct
+{
+
+	i32 fd;
+
+	u32 *sq_head;
+	u32 *sq_tail;
+	u32 *sq_mask;
+	u32 *sq_array;
+	u32 sq_entries;
+	struct io_uring_sqe *sqes;
+
+	u32 *cq_head;
+	u32 *cq_tail;
+	u32 *cq_mask;
+	struct io_uring_cqe *cqes;
+
+	void *sq_ptr;
+	size_t sq_size;
+	void *cq_ptr;
+	size_t cq_size;
+	size_t sqes_size;
+
+	Mutex sq_mutex;
+	u32 sq_pending;
+
+	// Requests whose submission failed, completed outside the sq mutex
+	u32 dropped[FILE_ASYNC_MAX];
+	u32 dropped_count;
+
+	Thread thread;
+
+} FileUring;
+
+#endif
+
+typedef struct
+{
+
+	FileReadRequest requests[FILE_ASYNC_MAX];
+	u32 free_list; // Index + 1, 0 if there are no free requests
+	Mutex mutex;
+
+#if SV_PLATFORM_LINUX
+	FileUring uring;
+	b8 use_uring;
+#endif
+
+} FileAsyncData;
+
+static FileAsyncData *file_async = NULL;
+
+SV_INLINE FileRead _file_read_handle(FileReadRequest *request)
+{
+	u32 index = (u32)(request - file_async->requests);
+	return ((u64)request->generation << 32) | (u64)(index + 1);
+}
+
+SV_INLINE FileReadRequest *_file_read_from_handle(FileRead handle)
+{
+	u32 index = (u32)(handle & 0xFFFFFFFF);
+
+	if (index == 0 || index > FILE_ASYNC_MAX)
+		return NULL;
+
+	FileReadRequest *request = file_async->requests + (index - 1);
+
+	if (request->generation != (u32)(handle >> 32))
+		return NULL;
+
+	return request;
+}
+
+static FileReadRequest *_file_read_allocate()
+{
+	while (TRUE)
+	{
+		mutex_lock(file_async->mutex);
+
+		if (file_async->free_list)
+		{
+			FileReadRequest *request = file_async->requests + (file_async->free_list - 1);
+			file_async->free_list = request->next_free;
+
+			mutex_unlock(file_async->mutex);
+			return request;
+		}
+
+		mutex_unlock(file_async->mutex);
+
+		// Every request is in flight, the completions are tasks and this thread can be the one that has to run them
+		if (!_task_help())
+			thread_yield();
+	}
+}
+
+// After this the cancellation has no effect, the handle is not valid anymore
+static void _file_read_invalidate(FileReadRequest *request)
+{
+	mutex_lock(file_async->mutex);
+	request->generation++;
+	mutex_unlock(file_async->mutex);
+}
+
+static void _file_read_free(FileReadRequest *request)
+{
+	mutex_lock(file_async->mutex);
+
+	request->next_free = file_async->free_list;
+	file_async->free_list = (u32)(request - file_async->requests) + 1;
+
+	mutex_unlock(file_async->mutex);
+}
+
+static void _file_read_finish(FileReadRequest *request)
+{
+	_file_read_invalidate(request);
+
+	FileReadResult result;
+	result.cancelled = _atomic_load_u32(&request->cancelled) != 0;
+	result.success = request->success && !result.cancelled;
+	result.data = result.success ? request->data : NULL;
+	result.size = result.success ? request->size : 0;
+	result.user_data = request->user_data;
+
+	if (!result.success && request->data)
+		memory_free(request->data);
+
+	if (request->callback)
+		request->callback(&result);
+	else if (result.data)
+		memory_free(result.data);
+
+	TaskContext *context = request->context;
+
+	_file_read_free(request);
+	_task_context_release(context);
+}
+
+// Completions are delivered as tasks, the callbacks never run in the io thread
+static void task_file_read_complete(void *arg)
+{
+	FileReadRequest *request = *(FileReadRequest **)arg;
+	_file_read_finish(request);
+}
+
+static void _file_read_dispatch_completion(FileReadRequest *request)
+{
+	TaskDesc desc;
+	desc.fn = task_file_read_complete;
+	desc.data = &request;
+	desc.size = sizeof(FileReadRequest *);
+
+	task_dispatch(&desc, 1, NULL);
+}
+
+///////////////////////////// BLOCKING FALLBACK ////////////////////////////
+
+// Used when there is no async backend, the read is a low priority task of the task system
+static void task_file_read_blocking(void *arg)
+{
+	FileReadRequest *request = *(FileReadRequest **)arg;
+
+	if (!_atomic_load_u32(&request->cancelled))
+	{
+		if (request->text)
+			request->success = file_read_text(request->type, request->filepath, &request->data, &request->size);
+		else
+			request->success = file_read_binary(request->type, request->filepath, &request->data, &request->size);
+	}
+
+	_file_read_finish(request);
+}
+
+static void _file_read_submit_blocking(FileReadRequest *request)
+{
+	TaskDesc desc;
+	desc.fn = task_file_read_blocking;
+	desc.data = &request;
+	desc.size = sizeof(FileReadRequest *);
+
+	task_dispatch_priority(&desc, 1, NULL, TaskPriority_Low);
+}
+
+///////////////////////////// IO_URING ////////////////////////////
+
+#if SV_PLATFORM_LINUX
+
+// The user close() declared in hosebase.h hides the one in unistd.h
+SV_INLINE void _file_fd_close(i32 fd)
+{
+	syscall(SYS_close, fd);
+}
+
+SV_INLINE i32 io_uring_setup(u32 entries, struct io_uring_params *params)
+{
+	return (i32)syscall(__NR_io_uring_setup, entries, params);
+}
+
+SV_INLINE i32 io_uring_enter(i32 fd, u32 to_submit, u32 min_complete, u32 flags)
+{
+	return (i32)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+// Must be called with the sq mutex locked, returns NULL if the ring is full
+static struct io_uring_sqe *_file_uring_sqe()
+{
+	FileUring *uring = &file_async->uring;
+
+	u32 head = _atomic_load_u32(uring->sq_head);
+	u32 tail = *uring->sq_tail;
+
+	if (tail - head >= uring->sq_entries)
+		return NULL;
+
+	u32 index = tail & *uring->sq_mask;
+
+	struct io_uring_sqe *sqe = uring->sqes + index;
+	memory_zero(sqe, sizeof(struct io_uring_sqe));
+
+	return sqe;
+}
+
+// Publishes the entry returned by _file_uring_sqe
+static void _file_uring_commit()
+{
+	FileUring *uring = &file_async->uring;
+
+	u32 tail = *uring->sq_tail;
+	u32 index = tail & *uring->sq_mask;
+
+	uring->sq_array[index] = index;
+	_atomic_store_u32(uring->sq_tail, tail + 1);
+	uring->sq_pending++;
+}
+
+// Must be called with the sq mutex locked
+static void _file_uring_flush()
+{
+	FileUring *uring = &file_async->uring;
+
+	while (uring->sq_pending)
+	{
+		i32 res = io_uring_enter(uring->fd, uring->sq_pending, 0, 0);
+
+		if (res >= 0)
+			uring->sq_pending -= SV_MIN((u32)res, uring->sq_pending);
+		else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+		{
+			SV_LOG_ERROR("io_uring submission failed: %i\n", errno);
+
+			// Nothing was consumed, the entries are taken back and their requests fail
+			u32 head = _atomic_load_u32(uring->sq_head);
+			u32 tail = *uring->sq_tail;
+
+			for (u32 i = head; i != tail; ++i)
+			{
+				struct io_uring_sqe *sqe = uring->sqes + uring->sq_array[i & *uring->sq_mask];
+				u64 user_data = sqe->user_data;
+
+				if (user_data == FILE_URING_STOP || user_data == FILE_URING_IGNORE)
+					continue;
+
+				uring->dropped[uring->dropped_count++] = (u32)(user_data & 0xFFFFFFFF) - 1;
+			}
+
+			_atomic_store_u32(uring->sq_tail, head);
+			uring->sq_pending = 0;
+			break;
+		}
+	}
+}
+
+static void _file_uring_done(FileReadRequest *request, b8 success);
+
+// Must be called with the sq mutex unlocked, the completions can push new reads
+static void _file_uring_fail_dropped()
+{
+	FileUring *uring = &file_async->uring;
+
+	while (TRUE)
+	{
+		mutex_lock(uring->sq_mutex);
+
+		if (uring->dropped_count == 0)
+		{
+			mutex_unlock(uring->sq_mutex);
+			break;
+		}
+
+		u32 index = uring->dropped[--uring->dropped_count];
+		mutex_unlock(uring->sq_mutex);
+
+		_file_uring_done(file_async->requests + index, FALSE);
+	}
+}
+
+// Pushes an operation, flushes and retries while the submission ring is full
+static void _file_uring_push(u8 opcode, i32 fd, void *addr, u32 len, u64 offset, u64 user_data, b8 flush)
+{
+	FileUring *uring = &file_async->uring;
+
+	mutex_lock(uring->sq_mutex);
+
+	struct io_uring_sqe *sqe;
+
+	while ((sqe = _file_uring_sqe()) == NULL)
+	{
+		_file_uring_flush();
+
+		mutex_unlock(uring->sq_mutex);
+		thread_yield();
+		mutex_lock(uring->sq_mutex);
+	}
+
+	sqe->opcode = opcode;
+	sqe->fd = fd;
+	sqe->addr = (u64)(size_t)addr;
+	sqe->len = len;
+	sqe->off = offset;
+	sqe->user_data = user_data;
+
+	_file_uring_commit();
+
+	if (flush)
+		_file_uring_flush();
+
+	mutex_unlock(uring->sq_mutex);
+
+	_file_uring_fail_dropped();
+}
+
+static void _file_uring_flush_locked()
+{
+	mutex_lock(file_async->uring.sq_mutex);
+	_file_uring_flush();
+	mutex_unlock(file_async->uring.sq_mutex);
+
+	_file_uring_fail_dropped();
+}
+
+SV_INLINE void _file_uring_read_next(FileReadRequest *request, b8 flush)
+{
+	_file_uring_push(IORING_OP_READ, request->fd, request->data + request->offset, request->size - request->offset, request->offset, _file_read_handle(request), flush);
+}
+
+static void _file_uring_done(FileReadRequest *request, b8 success)
+{
+	if (request->fd >= 0)
+	{
+		_file_fd_close(request->fd);
+		request->fd = -1;
+	}
+
+	request->success = success;
+
+	if (request->text && request->data)
+		request->data[request->size] = '\0';
+
+	_file_read_dispatch_completion(request);
+}
+
+// Opens the file in the calling thread, the size is needed to allocate the buffer
+static void _file_read_submit_uring(FileReadRequest *request, b8 flush)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, request->filepath, request->type);
+
+	request->fd = open(filepath, O_RDONLY | O_CLOEXEC);
+
+	struct stat st;
+
+	if (request->fd < 0 || fstat(request->fd, &st) != 0 || st.st_size > (off_t)u32_max - 1)
+	{
+		_file_uring_done(request, FALSE);
+		return;
+	}
+
+	request->size = (u32)st.st_size;
+	request->data = memory_allocate(request->size + (request->text ? 1 : 0));
+
+	if (request->size == 0)
+		_file_uring_done(request, TRUE);
+	else
+		_file_uring_read_next(request, flush);
+}
+
+static i32 file_uring_thread(void *arg)
+{
+	FileUring *uring = &file_async->uring;
+
+	while (TRUE)
+	{
+		i32 res = io_uring_enter(uring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+
+		if (res < 0 && errno != EINTR)
+		{
+			SV_LOG_ERROR("io_uring wait failed: %i\n", errno);
+			thread_sleep(1);
+		}
+
+		u32 head = *uring->cq_head;
+		u32 tail = _atomic_load_u32(uring->cq_tail);
+		b8 stop = FALSE;
+		b8 pushed = FALSE;
+
+		while (head != tail)
+		{
+			struct io_uring_cqe *cqe = uring->cqes + (head & *uring->cq_mask);
+			u64 user_data = cqe->user_data;
+			i32 result = cqe->res;
+
+			++head;
+
+			if (user_data == FILE_URING_STOP)
+			{
+				stop = TRUE;
+				continue;
+			}
+
+			if (user_data == FILE_URING_IGNORE)
+				continue;
+
+			// The request can't be reused until its completion is dispatched, the handle is always valid here
+			FileReadRequest *request = file_async->requests + ((user_data & 0xFFFFFFFF) - 1);
+
+			if (result == -EINTR || result == -EAGAIN)
+			{
+				_file_uring_read_next(request, FALSE);
+				pushed = TRUE;
+			}
+			else if (result < 0)
+			{
+				_file_uring_done(request, FALSE);
+			}
+			// Unexpected end of file
+			else if (result == 0)
+			{
+				request->size = request->offset;
+				_file_uring_done(request, TRUE);
+			}
+			else
+			{
+				request->offset += (u32)result;
+
+				if (request->offset < request->size && !_atomic_load_u32(&request->cancelled))
+				{
+					_file_uring_read_next(request, FALSE);
+					pushed = TRUE;
+				}
+				else
+					_file_uring_done(request, request->offset == request->size);
+			}
+		}
+
+		_atomic_store_u32(uring->cq_head, head);
+
+		if (pushed)
+			_file_uring_flush_locked();
+
+		if (stop)
+			break;
+	}
+
+	return 0;
+}
+
+static b8 _file_uring_initialize()
+{
+	FileUring *uring = &file_async->uring;
+
+	struct io_uring_params params;
+	memory_zero(&params, sizeof(params));
+
+	// Every read and cancel in flight needs room for its completion
+	params.flags = IORING_SETUP_CQSIZE;
+	params.cq_entries = FILE_URING_CQ_ENTRIES;
+
+	uring->fd = io_uring_setup(FILE_URING_ENTRIES, &params);
+
+	// Kernels older than 5.5 don't accept the cq size
+	if (uring->fd < 0 && errno == EINVAL)
+	{
+		memory_zero(&params, sizeof(params));
+		uring->fd = io_uring_setup(FILE_URING_ENTRIES, &params);
+	}
+
+	if (uring->fd < 0)
+		return FALSE;
+
+	// Without NODROP an overflowed completion is lost and its request never finishes
+	if (params.cq_entries < FILE_URING_CQ_ENTRIES && !(params.features & IORING_FEAT_NODROP))
+	{
+		_file_fd_close(uring->fd);
+		return FALSE;
+	}
+
+	uring->sq_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+	uring->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	uring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+	{
+		uring->sq_size = SV_MAX(uring->sq_size, uring->cq_size);
+		uring->cq_size = uring->sq_size;
+	}
+
+	uring->sq_ptr = mmap(NULL, uring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->fd, IORING_OFF_SQ_RING);
+
+	if (uring->sq_ptr == MAP_FAILED)
+	{
+		_file_fd_close(uring->fd);
+		return FALSE;
+	}
+
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+	{
+		uring->cq_ptr = uring->sq_ptr;
+	}
+	else
+	{
+		uring->cq_ptr = mmap(NULL, uring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->fd, IORING_OFF_CQ_RING);
+
+		if (uring->cq_ptr == MAP_FAILED)
+		{
+			munmap(uring->sq_ptr, uring->sq_size);
+			_file_fd_close(uring->fd);
+			return FALSE;
+		}
+	}
+
+	uring->sqes = mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->fd, IORING_OFF_SQES);
+
+	if (uring->sqes == MAP_FAILED)
+	{
+		if (uring->cq_ptr != uring->sq_ptr)
+			munmap(uring->cq_ptr, uring->cq_size);
+		munmap(uring->sq_ptr, uring->sq_size);
+		_file_fd_close(uring->fd);
+		return FALSE;
+	}
+
+	u8 *sq = uring->sq_ptr;
+	uring->sq_head = (u32 *)(sq + params.sq_off.head);
+	uring->sq_tail = (u32 *)(sq + params.sq_off.tail);
+	uring->sq_mask = (u32 *)(sq + params.sq_off.ring_mask);
+	uring->sq_array = (u32 *)(sq + params.sq_off.array);
+	uring->sq_entries = params.sq_entries;
+
+	u8 *cq = uring->cq_ptr;
+	uring->cq_head = (u32 *)(cq + params.cq_off.head);
+	uring->cq_tail = (u32 *)(cq + params.cq_off.tail);
+	uring->cq_mask = (u32 *)(cq + params.cq_off.ring_mask);
+	uring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+	uring->sq_mutex = mutex_create();
+	uring->thread = thread_create(file_uring_thread, NULL);
+
+	if (uring->thread == 0)
+	{
+		SV_LOG_ERROR("Can't create the io thread\n");
+		return FALSE;
+	}
+
+	thread_configure(uring->thread, "file_io", 0, ThreadPrority_High);
+
+	return TRUE;
+}
+
+static void _file_uring_close()
+{
+	FileUring *uring = &file_async->uring;
+
+	if (uring->thread)
+	{
+		_file_uring_push(IORING_OP_NOP, -1, NULL, 0, 0, FILE_URING_STOP, TRUE);
+		thread_wait(uring->thread);
+	}
+
+	munmap(uring->sqes, uring->sqes_size);
+	if (uring->cq_ptr != uring->sq_ptr)
+		munmap(uring->cq_ptr, uring->cq_size);
+	munmap(uring->sq_ptr, uring->sq_size);
+	_file_fd_close(uring->fd);
+
+	mutex_destroy(uring->sq_mutex);
+}
+
+#endif
+
+///////////////////////////// API ////////////////////////////
+
+b8 _file_async_initialize()
+{
+	file_async = memory_allocate(sizeof(FileAsyncData));
+	file_async->mutex = mutex_create();
+
+	foreach (i, FILE_ASYNC_MAX)
+	{
+		file_async->requests[i].next_free = (i + 1 < FILE_ASYNC_MAX) ? (i + 2) : 0;
+		file_async->requests[i].fd = -1;
+	}
+	file_async->free_list = 1;
+
+#if SV_PLATFORM_LINUX
+	file_async->use_uring = _file_uring_initialize();
+
+	if (!file_async->use_uring)
+	{
+		SV_LOG_WARNING("io_uring is not available, the async reads use the task system\n");
+	}
+#endif
+
+	return TRUE;
+}
+
+void _file_async_close()
+{
+	if (file_async == NULL)
+		return;
+
+#if SV_PLATFORM_LINUX
+	if (file_async->use_uring)
+		_file_uring_close();
+#endif
+
+	mutex_destroy(file_async->mutex);
+	memory_free(file_async);
+	file_async = NULL;
+}
+
+static FileRead _file_read_submit(const FileReadDesc *desc, TaskContext *context, b8 flush)
+{
+	FileReadRequest *request = _file_read_allocate();
+
+	request->callback = desc->callback;
+	request->user_data = desc->user_data;
+	request->context = context;
+	request->type = desc->type;
+	string_copy(request->filepath, desc->filepath, FILE_PATH_SIZE);
+	request->text = desc->text;
+	request->data = NULL;
+	request->size = 0;
+	request->offset = 0;
+	request->fd = -1;
+	request->success = FALSE;
+	request->cancelled = FALSE;
+
+	FileRead handle = _file_read_handle(request);
+
+	_task_context_retain(context);
+
+#if SV_PLATFORM_LINUX
+	if (file_async->use_uring)
+	{
+		_file_read_submit_uring(request, flush);
+		return handle;
+	}
+#endif
+
+	_file_read_submit_blocking(request);
+	return handle;
+}
+
+FileRead file_read_async(FilepathType type, const char *filepath, FileReadFn callback, void *user_data, TaskContext *context)
+{
+	FileReadDesc desc;
+	desc.type = type;
+	desc.filepath = filepath;
+	desc.callback = callback;
+	desc.user_data = user_data;
+	desc.text = FALSE;
+
+	return _file_read_submit(&desc, context, TRUE);
+}
+
+void file_read_async_batch(const FileReadDesc *reads, u32 count, TaskContext *context, FileRead *handles)
+{
+	// The reads are submitted to the kernel together
+	foreach (i, count)
+	{
+		FileRead handle = _file_read_submit(reads + i, context, FALSE);
+
+		if (handles)
+			handles[i] = handle;
+	}
+
+#if SV_PLATFORM_LINUX
+	if (file_async->use_uring)
+		_file_uring_flush_locked();
+#endif
+}
+
+b8 file_read_cancel(FileRead handle)
+{
+	b8 res = FALSE;
+
+	mutex_lock(file_async->mutex);
+
+	FileReadRequest *request = _file_read_from_handle(handle);
+
+	if (request)
+	{
+		_atomic_store_u32(&request->cancelled, TRUE);
+		res = TRUE;
+	}
+
+	mutex_unlock(file_async->mutex);
+
+#if SV_PLATFORM_LINUX
+	// Pushed without the mutex, a full ring can run completions in this thread.
+	// The handle is the user data of the read, a finished or reused request is not affected
+	if (res && file_async->use_uring)
+		_file_uring_push(IORING_OP_ASYNC_CANCEL, -1, (void *)(size_t)handle, 0, 0, FILE_URING_IGNORE, TRUE);
+#endif
+
+	return res;
+}
+
+#endif
@@ -0,0 +1,1354 @@
+#if SV_PLATFORM_LINUX
+
+#define _GNU_SOURCE
+
+#include "platform_internal.h"
+#include "Hosebase/input.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <time.h>
+#include <dirent.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/inotify.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include <execinfo.h>
+#include <linux/futex.h>
+
+typedef struct
+{
+	struct timespec start_timer;
+
+	v2_u32 window_size;
+	volatile sig_atomic_t close_request;
+
+} LinuxData;
+
+static LinuxData *linux_data = NULL;
+
+void os_futex_wait(volatile u32 *address, u32 value)
+{
+	syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+void os_futex_wake(volatile u32 *address, b8 all)
+{
+	syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, all ? i32_max : 1, NULL, NULL, 0);
+}
+
+Thread os_thread_current()
+{
+	return (Thread)pthread_self();
+}
+
+u32 os_processor_count()
+{
+	cpu_set_t set;
+	CPU_ZERO(&set);
+
+	if (sched_getaffinity(0, sizeof(set), &set) == 0)
+		return SV_MAX(CPU_COUNT(&set), 1);
+
+	return 1;
+}
+
+#define SYSFS_NUMA_NODE_MAX 64
+
+// Reads a small sysfs file, the path is prefix + n + suffix
+static b8 sysfs_read(char *buffer, u32 size, const char *prefix, u32 n, const char *suffix)
+{
+	char path[FILE_PATH_SIZE];
+	char n_str[30];
+
+	string_copy(path, prefix, FILE_PATH_SIZE);
+	string_from_u32(n_str, n);
+	string_append(path, n_str, FILE_PATH_SIZE);
+	string_append(path, suffix, FILE_PATH_SIZE);
+
+	FILE *file = fopen(path, "rb");
+	if (file == NULL)
+		return FALSE;
+
+	size_t read = fread(buffer, 1, size - 1, file);
+	fclose(file);
+
+	buffer[read] = '\0';
+	return read > 0;
+}
+
+SV_INLINE u32 sysfs_parse_u32(const char **it)
+{
+	u32 value = 0;
+
+	while (**it >= '0' && **it <= '9')
+	{
+		value = value * 10 + (u32)(**it - '0');
+		++*it;
+	}
+
+	return value;
+}
+
+static u32 sysfs_read_u32(const char *prefix, u32 n, const char *suffix, u32 default_value)
+{
+	char buffer[64];
+
+	if (!sysfs_read(buffer, sizeof(buffer), prefix, n, suffix) || buffer[0] < '0' || buffer[0] > '9')
+		return default_value;
+
+	const char *it = buffer;
+	return sysfs_parse_u32(&it);
+}
+
+// Format: "0-3,8,10-11"
+static void sysfs_parse_cpu_list(const char *it, CpuMask *mask)
+{
+	while (*it >= '0' && *it <= '9')
+	{
+		u32 begin = sysfs_parse_u32(&it);
+		u32 end = begin;
+
+		if (*it == '-')
+		{
+			++it;
+			end = sysfs_parse_u32(&it);
+		}
+
+		for (u32 cpu = begin; cpu <= end && cpu < SV_CPU_MAX; ++cpu)
+			cpu_mask_set(mask, cpu);
+
+		if (*it == ',')
+			++it;
+	}
+}
+
+u32 os_cpu_topology(CpuInfo *cpus, u32 max)
+{
+	cpu_set_t set;
+	CPU_ZERO(&set);
+
+	if (sched_getaffinity(0, sizeof(set), &set) != 0)
+		return 0;
+
+	CpuMask *nodes = memory_allocate(sizeof(CpuMask) * SYSFS_NUMA_NODE_MAX);
+	u32 node_count = 0;
+
+	// Without NUMA support the folder doesn't exist and everything is node 0
+	{
+		char buffer[1024];
+
+		foreach (node, SYSFS_NUMA_NODE_MAX)
+		{
+			if (sysfs_read(buffer, sizeof(buffer), "/sys/devices/system/node/node", node, "/cpulist"))
+			{
+				sysfs_parse_cpu_list(buffer, nodes + node);
+				node_count = node + 1;
+			}
+		}
+	}
+
+	u32 count = 0;
+
+	for (u32 cpu = 0; cpu < CPU_SETSIZE && count < max; ++cpu)
+	{
+		if (!CPU_ISSET(cpu, &set))
+			continue;
+
+		CpuInfo *info = cpus + count++;
+		info->id = cpu;
+		info->core = sysfs_read_u32("/sys/devices/system/cpu/cpu", cpu, "/topology/core_id", cpu);
+		info->package = sysfs_read_u32("/sys/devices/system/cpu/cpu", cpu, "/topology/physical_package_id", 0);
+		info->numa_node = 0;
+
+		foreach (node, node_count)
+		{
+			if (cpu_mask_test(nodes + node, cpu))
+			{
+				info->numa_node = node;
+				break;
+			}
+		}
+
+		// The arm kernels expose the capacity, the x86 hybrid cpus only differ in the maximum frequency
+		info->performance = sysfs_read_u32("/sys/devices/system/cpu/cpu", cpu, "/cpu_capacity", 0);
+
+		if (info->performance == 0)
+			info->performance = sysfs_read_u32("/sys/devices/system/cpu/cpu", cpu, "/cpufreq/cpuinfo_max_freq", 0) / 1000;
+	}
+
+	memory_free(nodes);
+
+	return count;
+}
+
+static void signal_handler(int signal)
+{
+	linux_data->close_request = TRUE;
+}
+
+void filepath_resolve(char *dst, const char *src, FilepathType type)
+{
+	if (path_is_absolute(src))
+		string_copy(dst, src, FILE_PATH_SIZE);
+	else
+	{
+		string_copy(dst, (type == FilepathType_Asset) ? "assets/" : "", FILE_PATH_SIZE);
+		string_append(dst, src, FILE_PATH_SIZE);
+	}
+}
+
+void filepath_user(char *dst)
+{
+	string_copy(dst, string_validate(getenv("HOME")), FILE_PATH_SIZE);
+}
+
+b8 os_initialize(const PlatformInitializeDesc *desc)
+{
+	linux_data = memory_allocate(sizeof(LinuxData));
+
+	clock_gettime(CLOCK_MONOTONIC, &linux_data->start_timer);
+
+	// There is no window backend, the window is always closed and only keeps the requested size
+	if (desc->window.open)
+	{
+		SV_LOG_WARNING("The linux platform runs without window\n");
+	}
+
+	linux_data->window_size = desc->window.size;
+
+	// Close request from the terminal
+	{
+		struct sigaction action;
+		memory_zero(&action, sizeof(action));
+		action.sa_handler = signal_handler;
+		sigemptyset(&action.sa_mask);
+
+		sigaction(SIGINT, &action, NULL);
+		sigaction(SIGTERM, &action, NULL);
+	}
+
+	thread_configure((Thread)pthread_self(), "main_thread", 0, ThreadPrority_Highest);
+
+	SV_CHECK(_task_initialize(desc));
+	SV_CHECK(_file_async_initialize());
+
+	return TRUE;
+}
+
+b8 input_focus()
+{
+	return FALSE;
+}
+
+b8 platform_recive_input()
+{
+	return !linux_data->close_request;
+}
+
+void os_close()
+{
+	if (linux_data)
+	{
+		_task_close();
+		_file_async_close();
+
+		memory_free(linux_data);
+		linux_data = NULL;
+	}
+}
+
+#if SV_SLOW
+
+void linux_print(PrintStyle style, const char *str, ...)
+{
+	va_list args;
+	va_start(args, str);
+
+	FILE *stream = stdout;
+
+	switch (style)
+	{
+
+	case PrintStyle_Warning:
+		stream = stderr;
+		fputs("\x1b[35m", stream);
+		break;
+
+	case PrintStyle_Error:
+		stream = stderr;
+		fputs("\x1b[31m", stream);
+		break;
+
+	default:
+		break;
+	}
+
+	vfprintf(stream, str, args);
+
+	if (style != PrintStyle_Info)
+		fputs("\x1b[0m", stream);
+
+	va_end(args);
+}
+
+#endif
+
+void show_message(const char *title, const char *content, b8 error)
+{
+	fprintf(error ? stderr : stdout, "[%s] %s\n", title, content);
+}
+
+b8 show_dialog_yesno(const char *title, const char *content)
+{
+	return FALSE;
+}
+
+// Window
+
+u64 window_handle()
+{
+	return 0;
+}
+
+v2_u32 window_size()
+{
+	return linux_data->window_size;
+}
+
+WindowState window_state()
+{
+	return WindowState_Windowed;
+}
+
+void set_window_fullscreen(b8 fullscreen)
+{
+}
+
+v2_u32 desktop_size()
+{
+	return linux_data->window_size;
+}
+
+// Cursor
+
+void cursor_hide()
+{
+}
+
+void cursor_show()
+{
+}
+
+// File Management
+
+b8 file_dialog_open(char *buff, u32 filterCount, const char **filters, const char *startPath)
+{
+	return FALSE;
+}
+
+b8 file_dialog_save(char *buff, u32 filterCount, const char **filters, const char *startPath)
+{
+	return FALSE;
+}
+
+void path_clear(char *path)
+{
+	while (*path != '\0')
+	{
+
+		if (*path == '\\')
+		{
+			*path = '/';
+		}
+
+		++path;
+	}
+}
+
+SV_INLINE b8 file_read(FilepathType type, const char *filepath_, u8 **data, u32 *psize, b8 text)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	FILE *file = fopen(filepath, "rb");
+
+	if (file == NULL)
+	{
+		return FALSE;
+	}
+
+	fseek(file, 0, SEEK_END);
+	u32 size = (u32)ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	*psize = size;
+	*data = memory_allocate(size + (text ? 1 : 0));
+
+	if (size && fread(*data, size, 1, file) != 1)
+	{
+		memory_free(*data);
+		*data = NULL;
+		fclose(file);
+		return FALSE;
+	}
+
+	if (text)
+		(*data)[size] = '\0';
+
+	fclose(file);
+	return TRUE;
+}
+
+b8 file_read_binary(FilepathType type, const char *filepath, u8 **data, u32 *psize)
+{
+	return file_read(type, filepath, data, psize, FALSE);
+}
+
+b8 file_read_text(FilepathType type, const char *filepath, u8 **data, u32 *psize)
+{
+	return file_read(type, filepath, data, psize, TRUE);
+}
+
+SV_INLINE b8 create_path(const char *filepath)
+{
+	char folder[FILE_PATH_SIZE] = "\0";
+
+	while (TRUE)
+	{
+
+		size_t folder_size = strlen(folder);
+
+		const char *it = filepath + folder_size;
+		while (*it && *it != '/')
+			++it;
+
+		if (*it == '\0')
+			break;
+		else
+			++it;
+
+		if (*it == '\0')
+			break;
+
+		folder_size = it - filepath;
+		memory_copy(folder, filepath, folder_size);
+		folder[folder_size] = '\0';
+
+		if (folder_size == 1u && folder[0] == '/')
+			continue;
+
+		if (mkdir(folder, 0755) != 0 && errno != EEXIST)
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+SV_INLINE b8 file_write(FilepathType type, const char *filepath_, const void *data, size_t size, b8 append, b8 recursive)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	const char *mode = append ? "ab" : "wb";
+
+	FILE *file = fopen(filepath, mode);
+
+	if (file == NULL)
+	{
+		if (recursive)
+		{
+
+			if (!create_path(filepath))
+				return FALSE;
+
+			file = fopen(filepath, mode);
+			if (file == NULL)
+				return FALSE;
+		}
+		else
+			return FALSE;
+	}
+
+	b8 res = TRUE;
+
+	if (size)
+		res = fwrite(data, size, 1, file) == 1;
+
+	fclose(file);
+	return res;
+}
+
+b8 file_write_binary(FilepathType type, const char *filepath, const u8 *data, size_t size, b8 append, b8 recursive)
+{
+	return file_write(type, filepath, data, size, append, recursive);
+}
+
+b8 file_write_text(FilepathType type, const char *filepath, const char *str, size_t size, b8 append, b8 recursive)
+{
+	return file_write(type, filepath, str, size, append, recursive);
+}
+
+SV_INLINE Date timespec_to_date(struct timespec time, b8 local)
+{
+	struct tm tm;
+
+	if (local)
+		localtime_r(&time.tv_sec, &tm);
+	else
+		gmtime_r(&time.tv_sec, &tm);
+
+	Date date;
+	date.year = (u32)tm.tm_year + 1900;
+	date.month = (u32)tm.tm_mon + 1;
+	date.day = (u32)tm.tm_mday;
+	date.hour = (u32)tm.tm_hour;
+	date.minute = (u32)tm.tm_min;
+	date.second = (u32)tm.tm_sec;
+	date.millisecond = (u32)(time.tv_nsec / 1000000);
+
+	return date;
+}
+
+f64 timer_now()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	time_t seconds = (now.tv_sec - linux_data->start_timer.tv_sec);
+	long nanos = (now.tv_nsec - linux_data->start_timer.tv_nsec);
+
+	return (f64)seconds + ((f64)nanos / 1000000000.0);
+}
+
+u64 timer_seed()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	u64 seed = now.tv_nsec;
+	seed = hash_combine(seed, 0x38F68DA62D73ULL);
+	seed = hash_combine(seed, now.tv_sec);
+
+	return seed;
+}
+
+Date timer_date()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	return timespec_to_date(now, TRUE);
+}
+
+b8 file_date(FilepathType type, const char *filepath_, Date *create, Date *last_write, Date *last_access)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	struct stat s;
+
+	if (stat(filepath, &s) != 0)
+		return FALSE;
+
+	// Linux doesn't store the creation date, the last status change is the closest thing
+	if (create)
+		*create = timespec_to_date(s.st_ctim, FALSE);
+	if (last_access)
+		*last_access = timespec_to_date(s.st_atim, FALSE);
+	if (last_write)
+		*last_write = timespec_to_date(s.st_mtim, FALSE);
+
+	return TRUE;
+}
+
+// The user close() declared in hosebase.h replaces the one in unistd.h at link time
+SV_INLINE void fd_close(i32 fd)
+{
+	syscall(SYS_close, fd);
+}
+
+b8 file_map(FilepathType type, const char *filepath_, FileView *view)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	memory_zero(view, sizeof(FileView));
+
+	i32 fd = open(filepath, O_RDONLY | O_CLOEXEC);
+
+	if (fd < 0)
+		return FALSE;
+
+	struct stat s;
+
+	if (fstat(fd, &s) != 0 || s.st_size > (off_t)u32_max)
+	{
+		fd_close(fd);
+		return FALSE;
+	}
+
+	if (s.st_size)
+	{
+		void *data = mmap(NULL, (size_t)s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (data == MAP_FAILED)
+		{
+			fd_close(fd);
+			return FALSE;
+		}
+
+		view->data = (const u8 *)data;
+		view->size = (u32)s.st_size;
+	}
+
+	// The mapping keeps the file referenced
+	fd_close(fd);
+	return TRUE;
+}
+
+void file_unmap(FileView *view)
+{
+	if (view->data)
+		munmap((void *)view->data, view->size);
+
+	memory_zero(view, sizeof(FileView));
+}
+
+b8 file_remove(FilepathType type, const char *filepath_)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	return remove(filepath) == 0;
+}
+
+b8 file_copy(FilepathType type, const char *srcpath_, const char *dstpath_)
+{
+	char srcpath[FILE_PATH_SIZE];
+	char dstpath[FILE_PATH_SIZE];
+	filepath_resolve(srcpath, srcpath_, type);
+	filepath_resolve(dstpath, dstpath_, type);
+
+	FILE *src = fopen(srcpath, "rb");
+	if (src == NULL)
+		return FALSE;
+
+	FILE *dst = fopen(dstpath, "wb");
+
+	if (dst == NULL)
+	{
+		create_path(dstpath);
+		dst = fopen(dstpath, "wb");
+
+		if (dst == NULL)
+		{
+			fclose(src);
+			return FALSE;
+		}
+	}
+
+	b8 res = TRUE;
+	u8 buffer[4096];
+
+	while (res)
+	{
+		size_t size = fread(buffer, 1, sizeof(buffer), src);
+
+		if (size == 0)
+			break;
+
+		res = fwrite(buffer, 1, size, dst) == size;
+	}
+
+	fclose(src);
+	fclose(dst);
+
+	return res;
+}
+
+b8 file_exists(FilepathType type, const char *filepath_)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	struct stat s;
+	return stat(filepath, &s) == 0;
+}
+
+b8 folder_create(FilepathType type, const char *filepath_, b8 recursive)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	if (recursive)
+		create_path(filepath);
+	return mkdir(filepath, 0755) == 0;
+}
+
+b8 folder_remove(FilepathType type, const char *filepath_)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	return remove(filepath) == 0;
+}
+
+SV_INLINE FolderElement dirent_to_folderelement(DIR *dir, struct dirent *d)
+{
+	FolderElement e;
+	memory_zero(&e, sizeof(e));
+
+	struct stat s;
+	if (fstatat(dirfd(dir), d->d_name, &s, 0) == 0)
+	{
+		e.is_file = !S_ISDIR(s.st_mode);
+		e.create_date = timespec_to_date(s.st_ctim, FALSE);
+		e.last_write_date = timespec_to_date(s.st_mtim, FALSE);
+		e.last_access_date = timespec_to_date(s.st_atim, FALSE);
+	}
+	else
+		e.is_file = d->d_type != DT_DIR;
+
+	string_copy(e.name, d->d_name, FILE_NAME_SIZE + 1u);
+	size_t size = strlen(e.name);
+	if (size == 0u)
+		e.extension = NULL;
+	else
+	{
+		const char *begin = e.name;
+		const char *it = begin + size;
+
+		while (it != begin && *it != '.')
+		{
+			--it;
+		}
+
+		if (it == begin)
+		{
+			e.extension = NULL;
+		}
+		else
+		{
+			assert(*it == '.');
+			e.extension = it + 1u;
+		}
+	}
+	return e;
+}
+
+FolderIterator folder_iterator_begin(FilepathType type, const char *folderpath_)
+{
+	char folderpath[FILE_PATH_SIZE];
+	filepath_resolve(folderpath, folderpath_, type);
+
+	if (folderpath[0] == '\0')
+		string_copy(folderpath, ".", FILE_PATH_SIZE);
+
+	FolderIterator iterator;
+	iterator.has_next = FALSE;
+
+	DIR *dir = opendir(folderpath);
+
+	if (dir == NULL)
+		return iterator;
+
+	iterator._handle = (u64)dir;
+	iterator.has_next = TRUE;
+	folder_iterator_next(&iterator);
+
+	return iterator;
+}
+
+void folder_iterator_next(FolderIterator *it)
+{
+	DIR *dir = (DIR *)it->_handle;
+
+	struct dirent *d = readdir(dir);
+
+	if (d != NULL)
+	{
+		it->element = dirent_to_folderelement(dir, d);
+	}
+	else
+	{
+		it->has_next = FALSE;
+		closedir(dir);
+	}
+}
+
+void folder_iterator_close(FolderIterator *it)
+{
+	DIR *dir = (DIR *)it->_handle;
+	if (it->has_next)
+		closedir(dir);
+}
+
+//////////////////////////////// FILE WATCHER ////////////////////////////
+
+// The folders are watched instead of the files, the editors usually save replacing the file
+
+typedef struct
+{
+	i32 wd;
+	u32 file_count;
+} WatchFolder;
+
+typedef struct
+{
+	i32 wd;
+	FilepathType type;
+	char filepath[FILE_PATH_SIZE]; // As it was added
+	u32 name_offset;
+	b8 queued;
+} WatchFile;
+
+typedef struct
+{
+	i32 fd;
+	HashMap(WatchFolder) folders; // By descriptor
+	HashMap(WatchFile) files;	  // By type and path
+	HashMap(u64) names;			  // Descriptor and name of the events to the file hash
+	DynamicArray(u64) changes;	  // File hashes
+} FileWatcherData;
+
+SV_INLINE u32 watch_name_offset(const char *filepath)
+{
+	u32 offset = 0;
+
+	for (u32 i = 0; filepath[i] != '\0'; ++i)
+	{
+		if (filepath[i] == '/')
+			offset = i + 1;
+	}
+
+	return offset;
+}
+
+SV_INLINE u64 watch_file_hash(FilepathType type, const char *filepath)
+{
+	return hash_combine(hash_string(filepath), (u64)type + 1);
+}
+
+SV_INLINE u64 watch_name_hash(i32 wd, const char *name)
+{
+	return hash_combine(hash_string(name), (u64)(u32)wd + 1);
+}
+
+SV_INLINE u64 watch_folder_hash(i32 wd)
+{
+	return (u64)(u32)wd + 1;
+}
+
+FileWatcher file_watcher_create()
+{
+	i32 fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (fd < 0)
+	{
+		SV_LOG_ERROR("Can't initialize inotify: %i\n", errno);
+		return 0;
+	}
+
+	FileWatcherData *data = memory_allocate(sizeof(FileWatcherData));
+	data->fd = fd;
+	data->folders = hashmap_init(WatchFolder);
+	data->files = hashmap_init(WatchFile);
+	data->names = hashmap_init(u64);
+	data->changes = array_init(u64, 2.f);
+
+	return (FileWatcher)data;
+}
+
+void file_watcher_destroy(FileWatcher watcher)
+{
+	FileWatcherData *data = (FileWatcherData *)watcher;
+
+	if (data == NULL)
+		return;
+
+	fd_close(data->fd);
+
+	hashmap_close(&data->folders);
+	hashmap_close(&data->files);
+	hashmap_close(&data->names);
+	array_close(&data->changes);
+
+	memory_free(data);
+}
+
+b8 file_watcher_add(FileWatcher watcher, FilepathType type, const char *filepath)
+{
+	FileWatcherData *data = (FileWatcherData *)watcher;
+
+	if (data == NULL)
+		return FALSE;
+
+	u64 hash = watch_file_hash(type, filepath);
+
+	if (hashmap_get(&data->files, hash))
+		return TRUE;
+
+	char folderpath[FILE_PATH_SIZE];
+	filepath_resolve(folderpath, filepath, type);
+
+	u32 offset = watch_name_offset(folderpath);
+
+	if (offset == 0)
+		string_copy(folderpath, ".", FILE_PATH_SIZE);
+	else
+		folderpath[offset] = '\0';
+
+	// The same folder returns the same descriptor
+	i32 wd = inotify_add_watch(data->fd, folderpath, IN_CLOSE_WRITE | IN_MOVED_TO);
+
+	if (wd < 0)
+	{
+		SV_LOG_ERROR("Can't watch the folder '%s': %i\n", folderpath, errno);
+		return FALSE;
+	}
+
+	b8 created;
+	WatchFolder *folder = (WatchFolder *)hashmap_insert(&data->folders, watch_folder_hash(wd), &created);
+
+	if (created)
+	{
+		folder->wd = wd;
+		folder->file_count = 0;
+	}
+
+	folder->file_count++;
+
+	WatchFile *file = (WatchFile *)hashmap_insert(&data->files, hash, NULL);
+	file->wd = wd;
+	file->type = type;
+	string_copy(file->filepath, filepath, FILE_PATH_SIZE);
+	file->name_offset = watch_name_offset(file->filepath);
+	file->queued = FALSE;
+
+	// The same file added with another path type replaces the previous one
+	u64 *name = (u64 *)hashmap_insert(&data->names, watch_name_hash(wd, file->filepath + file->name_offset), NULL);
+	*name = hash;
+
+	return TRUE;
+}
+
+void file_watcher_remove(FileWatcher watcher, FilepathType type, const char *filepath)
+{
+	FileWatcherData *data = (FileWatcherData *)watcher;
+
+	if (data == NULL)
+		return;
+
+	u64 hash = watch_file_hash(type, filepath);
+	WatchFile *file = (WatchFile *)hashmap_get(&data->files, hash);
+
+	if (file == NULL)
+		return;
+
+	i32 wd = file->wd;
+	u64 name_hash = watch_name_hash(wd, file->filepath + file->name_offset);
+
+	u64 *name = (u64 *)hashmap_get(&data->names, name_hash);
+
+	if (name && *name == hash)
+		hashmap_erase(&data->names, name_hash);
+
+	// The queued changes of the removed files are skipped
+	hashmap_erase(&data->files, hash);
+
+	WatchFolder *folder = (WatchFolder *)hashmap_get(&data->folders, watch_folder_hash(wd));
+
+	if (folder && --folder->file_count == 0)
+	{
+		inotify_rm_watch(data->fd, wd);
+		hashmap_erase(&data->folders, watch_folder_hash(wd));
+	}
+}
+
+static void watch_read_events(FileWatcherData *data)
+{
+	u8 buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+	while (TRUE)
+	{
+		ssize_t size = read(data->fd, buffer, sizeof(buffer));
+
+		if (size <= 0)
+			break;
+
+		for (u8 *it = buffer; it < buffer + size;)
+		{
+			struct inotify_event *event = (struct inotify_event *)it;
+			it += sizeof(struct inotify_event) + event->len;
+
+			if (event->len == 0 || !(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)))
+				continue;
+
+			u64 *name = (u64 *)hashmap_get(&data->names, watch_name_hash(event->wd, event->name));
+
+			if (name == NULL)
+				continue;
+
+			WatchFile *file = (WatchFile *)hashmap_get(&data->files, *name);
+
+			// A save can notify more than once
+			if (file == NULL || file->queued)
+				continue;
+
+			file->queued = TRUE;
+			array_push(&data->changes, *name);
+		}
+	}
+}
+
+b8 file_watcher_next(FileWatcher watcher, FilepathType *type, char *filepath)
+{
+	FileWatcherData *data = (FileWatcherData *)watcher;
+
+	if (data == NULL)
+		return FALSE;
+
+	if (data->changes.size == 0)
+		watch_read_events(data);
+
+	while (data->changes.size)
+	{
+		u64 hash = *(u64 *)array_last(&data->changes);
+		array_pop(&data->changes);
+
+		WatchFile *file = (WatchFile *)hashmap_get(&data->files, hash);
+
+		if (file == NULL || !file->queued)
+			continue;
+
+		file->queued = FALSE;
+
+		if (type)
+			*type = file->type;
+		string_copy(filepath, file->filepath, FILE_PATH_SIZE);
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+//////////////////////////////// CLIPBOARD ////////////////////////////
+
+b8 clipboard_write_ansi(const char *text)
+{
+	return FALSE;
+}
+
+const char *clipboard_read_ansi()
+{
+	return NULL;
+}
+
+//////////////////////////////// MULTITHREADING ////////////////////////////
+
+Mutex mutex_create()
+{
+	pthread_mutex_t *mutex = memory_allocate(sizeof(pthread_mutex_t));
+
+	if (pthread_mutex_init(mutex, NULL) != 0)
+	{
+		memory_free(mutex);
+		return 0;
+	}
+
+	return (Mutex)mutex;
+}
+
+void mutex_destroy(Mutex mutex)
+{
+	if (mutex)
+	{
+		pthread_mutex_destroy((pthread_mutex_t *)mutex);
+		memory_free((void *)mutex);
+	}
+}
+
+void mutex_lock(Mutex mutex)
+{
+	if (mutex)
+	{
+		pthread_mutex_lock((pthread_mutex_t *)mutex);
+	}
+
+	assert_title(mutex, "The mutex must be valid");
+}
+
+b8 mutex_try_lock(Mutex mutex)
+{
+	b8 lock = FALSE;
+
+	if (mutex)
+	{
+		lock = pthread_mutex_trylock((pthread_mutex_t *)mutex) == 0;
+	}
+
+	assert_title(mutex, "The mutex must be valid");
+	return lock;
+}
+
+void mutex_unlock(Mutex mutex)
+{
+	if (mutex)
+	{
+		pthread_mutex_unlock((pthread_mutex_t *)mutex);
+	}
+
+	assert_title(mutex, "The mutex must be valid");
+}
+
+typedef struct
+{
+	ThreadMainFn fn;
+	void *data;
+} ThreadStart;
+
+static void *thread_start(void *arg)
+{
+	ThreadStart start = *(ThreadStart *)arg;
+	memory_free(arg);
+
+	start.fn(start.data);
+
+	scratch_thread_close();
+	_memory_thread_close();
+	return NULL;
+}
+
+Thread thread_create(ThreadMainFn main, void *data)
+{
+	assert_static(sizeof(pthread_t) <= sizeof(Thread));
+
+	ThreadStart *start = memory_allocate(sizeof(ThreadStart));
+	start->fn = main;
+	start->data = data;
+
+	pthread_t thread;
+
+	if (pthread_create(&thread, NULL, thread_start, start) != 0)
+	{
+		SV_LOG_ERROR("Can't create a thread\n");
+		memory_free(start);
+		return 0;
+	}
+
+	return (Thread)thread;
+}
+
+void thread_destroy(Thread thread)
+{
+	if (thread)
+	{
+
+		pthread_cancel((pthread_t)thread);
+	}
+}
+
+void thread_wait(Thread thread)
+{
+	if (thread)
+	{
+
+		if (pthread_join((pthread_t)thread, NULL) != 0)
+		{
+			SV_LOG_ERROR("Can't wait a thread\n");
+		}
+	}
+
+	assert_title(thread, "The thread must be valid");
+}
+
+void thread_sleep(u64 millis)
+{
+	struct timespec ts;
+	ts.tv_sec = millis / 1000;
+	ts.tv_nsec = (millis % 1000) * 1000000;
+
+	while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+		;
+}
+
+u32 thread_stack_trace(void **frames, u32 max)
+{
+	void *buffer[64];
+	i32 count = backtrace(buffer, (i32)SV_MIN(max + 1, 64));
+
+	// The first frame is this function
+	u32 result = (count > 1) ? (u32)(count - 1) : 0;
+	memory_copy(frames, buffer + 1, result * sizeof(void *));
+	return result;
+}
+
+void thread_yield()
+{
+	sched_yield();
+}
+
+u64 thread_id()
+{
+	return (u64)syscall(SYS_gettid);
+}
+
+// Returns the cpu index of the n-th core that the process is allowed to run on
+SV_INLINE i32 affinity_cpu(u32 n)
+{
+	cpu_set_t set;
+	CPU_ZERO(&set);
+
+	if (sched_getaffinity(0, sizeof(set), &set) != 0)
+		return -1;
+
+	foreach (cpu, CPU_SETSIZE)
+	{
+		if (CPU_ISSET(cpu, &set))
+		{
+			if (n == 0)
+				return (i32)cpu;
+			--n;
+		}
+	}
+
+	return -1;
+}
+
+b8 thread_set_affinity(Thread thread, const CpuMask *mask)
+{
+	cpu_set_t set;
+	CPU_ZERO(&set);
+
+	for (u32 cpu = 0; cpu < CPU_SETSIZE && cpu < SV_CPU_MAX; ++cpu)
+	{
+		if (cpu_mask_test(mask, cpu))
+			CPU_SET(cpu, &set);
+	}
+
+	if (CPU_COUNT(&set) == 0)
+		return FALSE;
+
+	return pthread_setaffinity_np((pthread_t)thread, sizeof(set), &set) == 0;
+}
+
+void thread_configure(Thread thread, const char *name, u64 affinity_mask, ThreadPrority priority)
+{
+	pthread_t handle = (pthread_t)thread;
+
+	// Put the thread in a dedicated hardware core
+	if (affinity_mask)
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+
+		foreach (i, 64)
+		{
+			if (affinity_mask & (1ULL << (u64)i))
+			{
+				i32 cpu = affinity_cpu(i);
+				if (cpu >= 0)
+					CPU_SET(cpu, &set);
+			}
+		}
+
+		if (CPU_COUNT(&set))
+			pthread_setaffinity_np(handle, sizeof(set), &set);
+	}
+
+	// Set thread priority
+	// The nice value is per thread but only reachable through the kernel id, so it can only be applied from the thread itself.
+	// Raising it needs privileges, the servers usually run without them so failing is not an error
+	{
+		i32 nice;
+
+		switch (priority)
+		{
+
+		case ThreadPrority_Highest:
+			nice = -10;
+			break;
+
+		case ThreadPrority_High:
+			nice = -5;
+			break;
+
+		case ThreadPrority_Low:
+			nice = 5;
+			break;
+
+		case ThreadPrority_Lowest:
+			nice = 10;
+			break;
+
+		default:
+			nice = 0;
+			break;
+		}
+
+		if (pthread_equal(handle, pthread_self()))
+			setpriority(PRIO_PROCESS, (id_t)thread_id(), nice);
+	}
+
+	// Set thread name, linux limits it to 15 characters
+	{
+		char str[16];
+		string_copy(str, string_validate(name), sizeof(str));
+		pthread_setname_np(handle, str);
+	}
+}
+
+u32 interlock_increment_u32(volatile u32 *n)
+{
+	return __atomic_add_fetch(n, 1, __ATOMIC_SEQ_CST);
+}
+
+u32 interlock_decrement_u32(volatile u32 *n)
+{
+	return __atomic_sub_fetch(n, 1, __ATOMIC_SEQ_CST);
+}
+
+// DYNAMIC LIBRARIES
+
+Library library_load(FilepathType type, const char *filepath_)
+{
+	char filepath[FILE_PATH_SIZE];
+	filepath_resolve(filepath, filepath_, type);
+
+	void *library = dlopen(filepath, RTLD_NOW);
+
+	if (library == NULL)
+	{
+		SV_LOG_ERROR("%s\n", dlerror());
+	}
+
+	return (Library)library;
+}
+
+void library_free(Library library)
+{
+	if (library)
+		dlclose((void *)library);
+}
+
+void *library_address(Library library, const char *name)
+{
+	void *module = (void *)library;
+
+	if (module == NULL)
+		module = dlopen(NULL, RTLD_NOW);
+
+	return dlsym(module, name);
+}
+
+#endif
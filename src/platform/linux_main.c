@@ -0,0 +1,23 @@
+#if SV_PLATFORM_LINUX
+
+// The entry point lives apart from linux.c, the user close() declared in hosebase.h collides with the one in unistd.h
+
+#include "Hosebase/hosebase.h"
+
+int main()
+{
+	if (!initialize())
+		return 1;
+
+	while (hosebase_frame_begin())
+	{
+		update();
+		hosebase_frame_end();
+	}
+
+	close();
+
+	return 0;
+}
+
+#endif
@@ -1,21 +1,101 @@
-#include "Hosebase/platform.h"
+#include "platform_internal.h"
 
 typedef struct {
-	int a; // TODO:
+	CpuInfo* cpus;
+	u32 cpu_count;
+	u32 numa_node_count;
 } Platform;
 
 static Platform* platform;
 
-//////////// INTERNAL DEFINES /////////////
+static u32 lock_spin_max;
 
-b8 os_initialize(const PlatformInitializeDesc *desc);
-void os_close();
+#define SCRATCH_BLOCK_SIZE (256 * 1024)
 
-/////////////////////////////////////////
+static SV_THREAD_LOCAL LinearAllocator scratch_allocators[2];
+
+static void cpu_topology_initialize()
+{
+	CpuInfo* cpus = memory_allocate(sizeof(CpuInfo) * SV_CPU_MAX);
+	u32 count = os_cpu_topology(cpus, SV_CPU_MAX);
+
+	// Unknown topology, every processor is a core
+	if (count == 0)
+	{
+		count = SV_MIN(SV_MAX(os_processor_count(), 1), SV_CPU_MAX);
+
+		foreach (i, count)
+		{
+			cpus[i].id = i;
+			cpus[i].core = i;
+			cpus[i].package = 0;
+			cpus[i].numa_node = 0;
+			cpus[i].performance = 0;
+		}
+	}
+
+	// Sort by id
+	for (u32 i = 1; i < count; ++i)
+	{
+		CpuInfo cpu = cpus[i];
+		u32 j = i;
+
+		while (j > 0 && cpus[j - 1].id > cpu.id)
+		{
+			cpus[j] = cpus[j - 1];
+			--j;
+		}
+
+		cpus[j] = cpu;
+	}
+
+	// Dense core indices and position of each sibling inside the core
+	u32* core_keys = memory_allocate(sizeof(u32) * count);
+	foreach (i, count)
+		core_keys[i] = cpus[i].core;
+
+	u32 core_count = 0;
+	u32 numa_node_count = 0;
+
+	foreach (i, count)
+	{
+		u32 core = core_count;
+		u32 smt_index = 0;
+
+		foreach (j, i)
+		{
+			if (cpus[j].package == cpus[i].package && core_keys[j] == core_keys[i])
+			{
+				core = cpus[j].core;
+				smt_index++;
+			}
+		}
+
+		if (smt_index == 0)
+			core_count++;
+
+		numa_node_count = SV_MAX(numa_node_count, cpus[i].numa_node + 1);
+
+		cpus[i].core = core;
+		cpus[i].smt_index = smt_index;
+	}
+
+	memory_free(core_keys);
+
+	platform->cpus = cpus;
+	platform->cpu_count = count;
+	platform->numa_node_count = numa_node_count;
+}
 
 b8 platform_initialize(const PlatformInitializeDesc *desc)
 {
     platform = memory_allocate(sizeof(Platform));
+
+    cpu_topology_initialize();
+
+    // Spinning only helps if the owner can run meanwhile
+    lock_spin_max = (platform->cpu_count > 1) ? 100 : 0;
+
     return os_initialize(desc);
 }
 
@@ -23,10 +103,59 @@ void platform_close()
 {
     if (platform != NULL)
     {
+        memory_free(platform->cpus);
         memory_free(platform);
+        platform = NULL;
     }
 
     os_close();
+
+    scratch_thread_close();
+}
+
+const CpuInfo *cpu_topology(u32 *count)
+{
+	*count = platform->cpu_count;
+	return platform->cpus;
+}
+
+u32 cpu_numa_node_count()
+{
+	return platform->numa_node_count;
+}
+
+///////////////////////////////// SCRATCH MEMORY ///////////////////////////////
+
+Scratch scratch_begin_conflict(const LinearAllocator *conflict)
+{
+	LinearAllocator *alloc = scratch_allocators + ((conflict == scratch_allocators) ? 1 : 0);
+
+	if (alloc->block_size == 0)
+		*alloc = linear_allocator_init(SCRATCH_BLOCK_SIZE);
+
+	Scratch scratch;
+	scratch.allocator = alloc;
+	scratch.mark = linear_allocator_mark(alloc);
+	return scratch;
+}
+
+Scratch scratch_begin()
+{
+	return scratch_begin_conflict(NULL);
+}
+
+void scratch_end(Scratch scratch)
+{
+	linear_allocator_rewind(scratch.allocator, scratch.mark);
+}
+
+void scratch_thread_close()
+{
+	foreach (i, 2)
+	{
+		linear_allocator_close(scratch_allocators + i);
+		scratch_allocators[i].block_size = 0;
+	}
 }
 
 b8 path_is_absolute(const char *path)
@@ -34,10 +163,14 @@ b8 path_is_absolute(const char *path)
 	if (path == NULL)
 		return FALSE;
 
+#if SV_PLATFORM_LINUX
+	return path[0] == '/';
+#else
 	u32 size = string_size(path);
 	if (size < 2u)
 		return FALSE;
 	return path[1] == ':';
+#endif
 }
 
 /////////////////// WINDOW /////////////////////
@@ -46,4 +179,378 @@ f32 window_aspect()
 {
 	v2_u32 size = window_size();
 	return (f32)size.x / (f32)size.y;
-}
\ No newline at end of file
+}
+/////////////////// LIGHTWEIGHT LOCKS /////////////////////
+
+#define RWLOCK_WRITER 0x80000000
+
+void fast_mutex_lock(FastMutex *mutex)
+{
+	u32 state = 0;
+
+	if (atomic_cas_u32(&mutex->state, &state, 1, MemoryOrder_Acquire))
+		return;
+
+	// Spins up to twice the average that was needed before, like the adaptive mutex of glibc
+	u32 max = SV_MIN(lock_spin_max, mutex->spin * 2 + 10);
+	u32 count = 0;
+	b8 locked = FALSE;
+
+	while (count < max && !locked)
+	{
+		_cpu_relax();
+		++count;
+
+		state = atomic_load_u32(&mutex->state, MemoryOrder_Relaxed);
+		locked = state == 0 && atomic_cas_u32(&mutex->state, &state, 1, MemoryOrder_Acquire);
+	}
+
+	if (max)
+		mutex->spin = (u32)((i32)mutex->spin + ((i32)count - (i32)mutex->spin) / 8);
+
+	if (locked)
+		return;
+
+	// Whoever takes it from the sleeping state leaves it marked, the unlock must wake the rest
+	if (state != 2)
+		state = atomic_exchange_u32(&mutex->state, 2, MemoryOrder_Acquire);
+
+	while (state != 0)
+	{
+		os_futex_wait(&mutex->state, 2);
+		state = atomic_exchange_u32(&mutex->state, 2, MemoryOrder_Acquire);
+	}
+}
+
+b8 fast_mutex_try_lock(FastMutex *mutex)
+{
+	u32 state = 0;
+	return atomic_cas_u32(&mutex->state, &state, 1, MemoryOrder_Acquire);
+}
+
+void fast_mutex_unlock(FastMutex *mutex)
+{
+	if (atomic_exchange_u32(&mutex->state, 0, MemoryOrder_Release) == 2)
+		os_futex_wake(&mutex->state, FALSE);
+}
+
+// The waiters are counted before checking the state again, the unlocks only wake when someone sleeps
+static void rwlock_sleep(RWLock *lock, u32 state)
+{
+	atomic_fetch_add_u32(&lock->waiters, 1, MemoryOrder_SeqCst);
+	os_futex_wait(&lock->state, state);
+	atomic_fetch_add_u32(&lock->waiters, (u32)-1, MemoryOrder_Relaxed);
+}
+
+SV_INLINE void rwlock_wake(RWLock *lock)
+{
+	// Readers and the writer sleep in the same address, waking only one could leave the writer sleeping
+	if (atomic_load_u32(&lock->waiters, MemoryOrder_SeqCst))
+		os_futex_wake(&lock->state, TRUE);
+}
+
+void rwlock_read_lock(RWLock *lock)
+{
+	u32 spin = 0;
+
+	while (TRUE)
+	{
+		u32 state = atomic_load_u32(&lock->state, MemoryOrder_Relaxed);
+
+		if (!(state & RWLOCK_WRITER))
+		{
+			if (atomic_cas_u32(&lock->state, &state, state + 1, MemoryOrder_Acquire))
+				return;
+		}
+		else if (spin < lock_spin_max)
+		{
+			++spin;
+			_cpu_relax();
+		}
+		else
+			rwlock_sleep(lock, state);
+	}
+}
+
+b8 rwlock_try_read_lock(RWLock *lock)
+{
+	u32 state = atomic_load_u32(&lock->state, MemoryOrder_Relaxed);
+
+	while (!(state & RWLOCK_WRITER))
+	{
+		if (atomic_cas_u32(&lock->state, &state, state + 1, MemoryOrder_Acquire))
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+void rwlock_read_unlock(RWLock *lock)
+{
+	u32 state = atomic_fetch_add_u32(&lock->state, (u32)-1, MemoryOrder_SeqCst) - 1;
+
+	// The last reader lets the writer in
+	if (state == RWLOCK_WRITER)
+		rwlock_wake(lock);
+}
+
+void rwlock_write_lock(RWLock *lock)
+{
+	fast_mutex_lock(&lock->writer);
+
+	u32 state = atomic_fetch_add_u32(&lock->state, RWLOCK_WRITER, MemoryOrder_SeqCst) + RWLOCK_WRITER;
+	u32 spin = 0;
+
+	// Wait for the readers that came before
+	while (state != RWLOCK_WRITER)
+	{
+		if (spin < lock_spin_max)
+		{
+			++spin;
+			_cpu_relax();
+		}
+		else
+			rwlock_sleep(lock, state);
+
+		state = atomic_load_u32(&lock->state, MemoryOrder_Acquire);
+	}
+}
+
+void rwlock_write_unlock(RWLock *lock)
+{
+	atomic_fetch_add_u32(&lock->state, (u32)-RWLOCK_WRITER, MemoryOrder_SeqCst);
+	rwlock_wake(lock);
+
+	fast_mutex_unlock(&lock->writer);
+}
+
+void condvar_wait(CondVar *cv, FastMutex *mutex)
+{
+	atomic_fetch_add_u32(&cv->waiters, 1, MemoryOrder_SeqCst);
+	u32 sequence = atomic_load_u32(&cv->sequence, MemoryOrder_Relaxed);
+
+	fast_mutex_unlock(mutex);
+	os_futex_wait(&cv->sequence, sequence);
+
+	atomic_fetch_add_u32(&cv->waiters, (u32)-1, MemoryOrder_Relaxed);
+
+	// Locked as contended, the other woken threads may be sleeping in the mutex
+	while (atomic_exchange_u32(&mutex->state, 2, MemoryOrder_Acquire) != 0)
+		os_futex_wait(&mutex->state, 2);
+}
+
+void condvar_signal(CondVar *cv)
+{
+	atomic_fetch_add_u32(&cv->sequence, 1, MemoryOrder_SeqCst);
+
+	if (atomic_load_u32(&cv->waiters, MemoryOrder_SeqCst))
+		os_futex_wake(&cv->sequence, FALSE);
+}
+
+void condvar_broadcast(CondVar *cv)
+{
+	atomic_fetch_add_u32(&cv->sequence, 1, MemoryOrder_SeqCst);
+
+	if (atomic_load_u32(&cv->waiters, MemoryOrder_SeqCst))
+		os_futex_wake(&cv->sequence, TRUE);
+}
+
+/////////////////// LOCK-FREE CONTAINERS /////////////////////
+
+SV_INLINE u32 capacity_power_of_two(u32 capacity)
+{
+	u32 n = 2;
+	while (n < capacity)
+		n <<= 1;
+	return n;
+}
+
+void spsc_ring_init(SPSCRing *ring, u32 stride, u32 capacity)
+{
+	memory_zero(ring, sizeof(SPSCRing));
+
+	capacity = capacity_power_of_two(capacity);
+
+	ring->data = memory_allocate((size_t)stride * capacity);
+	ring->stride = stride;
+	ring->mask = capacity - 1;
+}
+
+void spsc_ring_close(SPSCRing *ring)
+{
+	if (ring->data)
+		memory_free(ring->data);
+
+	memory_zero(ring, sizeof(SPSCRing));
+}
+
+b8 spsc_ring_push(SPSCRing *ring, const void *data)
+{
+	u32 tail = atomic_load_u32(&ring->tail, MemoryOrder_Relaxed);
+
+	// The head is only read again when the cached one says the ring is full
+	if (tail - ring->cached_head > ring->mask)
+	{
+		ring->cached_head = atomic_load_u32(&ring->head, MemoryOrder_Acquire);
+
+		if (tail - ring->cached_head > ring->mask)
+			return FALSE;
+	}
+
+	memory_copy(ring->data + (size_t)(tail & ring->mask) * ring->stride, data, ring->stride);
+	atomic_store_u32(&ring->tail, tail + 1, MemoryOrder_Release);
+
+	return TRUE;
+}
+
+b8 spsc_ring_pop(SPSCRing *ring, void *data)
+{
+	u32 head = atomic_load_u32(&ring->head, MemoryOrder_Relaxed);
+
+	if (head == ring->cached_tail)
+	{
+		ring->cached_tail = atomic_load_u32(&ring->tail, MemoryOrder_Acquire);
+
+		if (head == ring->cached_tail)
+			return FALSE;
+	}
+
+	memory_copy(data, ring->data + (size_t)(head & ring->mask) * ring->stride, ring->stride);
+	atomic_store_u32(&ring->head, head + 1, MemoryOrder_Release);
+
+	return TRUE;
+}
+
+// Dmitry Vyukov's bounded queue, each slot has a sequence that says which lap can write or read it
+
+void mpmc_queue_init(MPMCQueue *queue, u32 stride, u32 capacity)
+{
+	memory_zero(queue, sizeof(MPMCQueue));
+
+	capacity = capacity_power_of_two(capacity);
+
+	queue->sequences = memory_allocate((sizeof(u32) + stride) * (size_t)capacity);
+	queue->data = (u8 *)(queue->sequences + capacity);
+	queue->stride = stride;
+	queue->mask = capacity - 1;
+
+	foreach (i, capacity)
+		queue->sequences[i] = i;
+}
+
+void mpmc_queue_close(MPMCQueue *queue)
+{
+	if (queue->sequences)
+		memory_free((void *)queue->sequences);
+
+	memory_zero(queue, sizeof(MPMCQueue));
+}
+
+b8 mpmc_queue_push(MPMCQueue *queue, const void *data)
+{
+	u32 pos = atomic_load_u32(&queue->enqueue_pos, MemoryOrder_Relaxed);
+
+	while (TRUE)
+	{
+		u32 index = pos & queue->mask;
+		i32 diff = (i32)(atomic_load_u32(queue->sequences + index, MemoryOrder_Acquire) - pos);
+
+		if (diff == 0)
+		{
+			if (atomic_cas_u32(&queue->enqueue_pos, &pos, pos + 1, MemoryOrder_Relaxed))
+			{
+				memory_copy(queue->data + (size_t)index * queue->stride, data, queue->stride);
+				atomic_store_u32(queue->sequences + index, pos + 1, MemoryOrder_Release);
+				return TRUE;
+			}
+		}
+		else if (diff < 0)
+			return FALSE;
+		else
+			pos = atomic_load_u32(&queue->enqueue_pos, MemoryOrder_Relaxed);
+	}
+}
+
+b8 mpmc_queue_pop(MPMCQueue *queue, void *data)
+{
+	u32 pos = atomic_load_u32(&queue->dequeue_pos, MemoryOrder_Relaxed);
+
+	while (TRUE)
+	{
+		u32 index = pos & queue->mask;
+		i32 diff = (i32)(atomic_load_u32(queue->sequences + index, MemoryOrder_Acquire) - (pos + 1));
+
+		if (diff == 0)
+		{
+			if (atomic_cas_u32(&queue->dequeue_pos, &pos, pos + 1, MemoryOrder_Relaxed))
+			{
+				memory_copy(data, queue->data + (size_t)index * queue->stride, queue->stride);
+				atomic_store_u32(queue->sequences + index, pos + queue->mask + 1, MemoryOrder_Release);
+				return TRUE;
+			}
+		}
+		else if (diff < 0)
+			return FALSE;
+		else
+			pos = atomic_load_u32(&queue->dequeue_pos, MemoryOrder_Relaxed);
+	}
+}
+
+// Dmitry Vyukov's intrusive queue, the push is a single exchange. The stub node keeps the list non empty
+
+void mpsc_queue_init(MPSCQueue *queue)
+{
+	queue->stub.next = NULL;
+	queue->head = &queue->stub;
+	queue->tail = &queue->stub;
+}
+
+void mpsc_queue_push(MPSCQueue *queue, MPSCNode *node)
+{
+	atomic_store_ptr((void *volatile *)&node->next, NULL, MemoryOrder_Relaxed);
+
+	MPSCNode *prev = (MPSCNode *)atomic_exchange_ptr((void *volatile *)&queue->head, node, MemoryOrder_AcqRel);
+
+	// Between the exchange and this store the consumer can't reach the node
+	atomic_store_ptr((void *volatile *)&prev->next, node, MemoryOrder_Release);
+}
+
+MPSCNode *mpsc_queue_pop(MPSCQueue *queue)
+{
+	MPSCNode *tail = queue->tail;
+	MPSCNode *next = (MPSCNode *)atomic_load_ptr((void *const volatile *)&tail->next, MemoryOrder_Acquire);
+
+	if (tail == &queue->stub)
+	{
+		if (next == NULL)
+			return NULL;
+
+		queue->tail = next;
+		tail = next;
+		next = (MPSCNode *)atomic_load_ptr((void *const volatile *)&next->next, MemoryOrder_Acquire);
+	}
+
+	if (next)
+	{
+		queue->tail = next;
+		return tail;
+	}
+
+	MPSCNode *head = (MPSCNode *)atomic_load_ptr((void *const volatile *)&queue->head, MemoryOrder_Acquire);
+
+	if (tail != head)
+		return NULL;
+
+	// The last node can't be returned while it's the head, the stub takes its place
+	mpsc_queue_push(queue, &queue->stub);
+
+	next = (MPSCNode *)atomic_load_ptr((void *const volatile *)&tail->next, MemoryOrder_Acquire);
+
+	if (next)
+	{
+		queue->tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Hosebase/platform.h"
+
+SV_BEGIN_C_HEADER
+
+// Atomics used by the internal systems
+
+SV_INLINE u32 _atomic_load_u32(volatile u32* p) { return atomic_load_u32(p, MemoryOrder_Acquire); }
+SV_INLINE void _atomic_store_u32(volatile u32* p, u32 v) { atomic_store_u32(p, v, MemoryOrder_Release); }
+SV_INLINE i64 _atomic_load_i64(volatile i64* p) { return (i64)atomic_load_u64((volatile u64*)p, MemoryOrder_Acquire); }
+SV_INLINE void _atomic_store_i64(volatile i64* p, i64 v) { atomic_store_u64((volatile u64*)p, (u64)v, MemoryOrder_Release); }
+SV_INLINE u32 _atomic_add_u32(volatile u32* p, u32 v) { return atomic_fetch_add_u32(p, v, MemoryOrder_SeqCst) + v; }
+SV_INLINE b8 _atomic_cas_u32(volatile u32* p, u32 expected, u32 desired) { return atomic_cas_u32(p, &expected, desired, MemoryOrder_SeqCst); }
+SV_INLINE b8 _atomic_cas_i64(volatile i64* p, i64 expected, i64 desired) { return atomic_cas_u64((volatile u64*)p, (u64*)&expected, (u64)desired, MemoryOrder_SeqCst); }
+SV_INLINE void _atomic_fence() { atomic_fence(MemoryOrder_SeqCst); }
+
+#if defined(_MSC_VER) && defined(_M_ARM64)
+SV_INLINE void _cpu_relax() { __yield(); }
+#elif defined(_MSC_VER)
+SV_INLINE void _cpu_relax() { _mm_pause(); }
+#elif defined(__x86_64__) || defined(__i386__)
+SV_INLINE void _cpu_relax() { __builtin_ia32_pause(); }
+#else
+SV_INLINE void _cpu_relax() {}
+#endif
+
+// OS layer, implemented by each platform
+
+b8   os_initialize(const PlatformInitializeDesc* desc);
+void os_close();
+
+// Blocks while *address == value, can return spuriously
+void os_futex_wait(volatile u32* address, u32 value);
+void os_futex_wake(volatile u32* address, b8 all);
+
+u32 os_processor_count();
+
+// Fills the processors that the process can use, returns the count.
+// The core only needs to be unique per physical core, the smt_index is computed later
+u32 os_cpu_topology(CpuInfo* cpus, u32 max);
+
+// Handle of the calling thread, valid for thread_set_affinity
+Thread os_thread_current();
+
+// Task system, shared by the platforms that run worker threads
+
+b8   _task_initialize(const PlatformInitializeDesc* desc);
+void _task_close();
+
+// Counts work completed outside the workers, like the async reads, in the context and in task_running(NULL)
+void _task_context_retain(TaskContext* context);
+void _task_context_release(TaskContext* context);
+
+// Executes one pending task, returns FALSE if there is none. For the threads that wait for something produced by tasks
+b8 _task_help();
+
+// Async file reading, shared by the platforms with task system
+
+b8   _file_async_initialize();
+void _file_async_close();
+
+SV_END_C_HEADER
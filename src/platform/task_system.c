@@ -0,0 +1,1691 @@
+#include "platform_internal.h"
+
+#if SV_PLATFORM_WINDOWS || SV_PLATFORM_LINUX
+
+#define TASK_DEQUE_SIZE 512 // Per worker and lane, must be power of two
+#define TASK_QUEUE_SIZE 4096 // Per lane
+#define TASK_RESERVE_QUEUE_SIZE 64
+#define TASK_CACHE_LINE 64
+#define TASK_WAIT_SPIN 64 // Empty searches before a waiting thread goes to sleep
+
+typedef struct
+{
+
+	TaskContext *context;
+	void *fn;
+	b8 user_data[TASK_DATA_SIZE];
+	f64 dispatch_time;
+	u8 type;
+	u8 priority;
+	b8 lane_slot; // Set by the thread that takes a task from a lane with worker limit
+
+} TaskData;
+
+typedef struct
+{
+	void *main_data;
+	volatile u32 *started;
+} TaskReserveData;
+
+// Chase-Lev deque, the owner pushes and pops at the bottom and the other threads steal from the top
+typedef struct
+{
+
+	volatile i64 top;
+	u8 _pad0[TASK_CACHE_LINE - sizeof(i64)];
+	volatile i64 bottom;
+	u8 _pad1[TASK_CACHE_LINE - sizeof(i64)];
+
+	TaskData tasks[TASK_DEQUE_SIZE];
+
+} TaskDeque;
+
+typedef struct
+{
+	u64 executed;
+	f64 latency_sum;
+	f64 latency_max;
+} TaskLaneCounters;
+
+typedef struct
+{
+
+	TaskDeque deques[TaskPriority_MaxEnum];
+
+	Thread thread;
+	u32 id;
+	u32 numa_node;
+
+	// Only written by the owner
+	volatile u32 dispatched;
+	volatile u32 completed;
+
+	u32 lane_depth[TaskPriority_MaxEnum];
+	TaskLaneCounters lanes[TaskPriority_MaxEnum];
+	u32 stats_epoch;
+
+	TaskWorkerStats stats;
+
+} TaskThreadData;
+
+typedef struct
+{
+
+	// The threads without deque submit their tasks here
+	MPMCQueue queues[TaskPriority_MaxEnum];
+	MPMCQueue reserve_queue;
+
+	// Workers executing tasks of each lane, only counted for the lanes with limit
+	volatile u32 lane_active[TaskPriority_MaxEnum];
+	volatile u32 lane_limit[TaskPriority_MaxEnum];
+
+	TaskThreadData *threads;
+	u32 thread_count;
+	u32 numa_node_count;
+
+	// Tasks dispatched and completed by threads that aren't workers
+	volatile u32 external_dispatched;
+	u8 _pad0[TASK_CACHE_LINE - sizeof(u32)];
+	volatile u32 external_completed;
+	u8 _pad1[TASK_CACHE_LINE - sizeof(u32)];
+
+	volatile u32 reserved_threads;
+
+	TaskLaneCounters external_lanes[TaskPriority_MaxEnum];
+	volatile u32 external_lanes_lock;
+	volatile u32 stats_epoch;
+
+	// Futex word, bumped when new work is published while some worker is sleeping
+	volatile u32 wake_signal;
+	volatile u32 sleeping_threads;
+
+	// Futex word for the threads blocked in task_wait, bumped when a context is drained
+	volatile u32 wait_signal;
+	volatile u32 waiting_threads;
+	volatile u32 global_waiters; // Waiting with null context, they need every completion
+
+	volatile b8 running;
+
+} TaskSystemData;
+
+static TaskSystemData *task_system = NULL;
+
+static SV_THREAD_LOCAL TaskThreadData *task_worker = NULL;
+static SV_THREAD_LOCAL u64 task_random = 0;
+
+SV_INLINE u32 _task_random()
+{
+	if (task_random == 0)
+		task_random = hash_combine(thread_id(), 0x8F7A6D5C4B3A2918ULL) | 1;
+
+	// xorshift64
+	task_random ^= task_random << 13;
+	task_random ^= task_random >> 7;
+	task_random ^= task_random << 17;
+	return (u32)task_random;
+}
+
+///////////////////////////// DEQUE ////////////////////////////
+
+static b8 _task_deque_push(TaskDeque *deque, const TaskData *task)
+{
+	i64 b = deque->bottom;
+	i64 t = _atomic_load_i64(&deque->top);
+
+	if (b - t >= TASK_DEQUE_SIZE)
+		return FALSE;
+
+	deque->tasks[b & (TASK_DEQUE_SIZE - 1)] = *task;
+	_atomic_store_i64(&deque->bottom, b + 1);
+
+	return TRUE;
+}
+
+static b8 _task_deque_pop(TaskDeque *deque, TaskData *task)
+{
+	i64 b = deque->bottom - 1;
+	_atomic_store_i64(&deque->bottom, b);
+	_atomic_fence();
+	i64 t = _atomic_load_i64(&deque->top);
+
+	b8 res = FALSE;
+
+	if (t <= b)
+	{
+		*task = deque->tasks[b & (TASK_DEQUE_SIZE - 1)];
+		res = TRUE;
+
+		// Last task, race against the thieves
+		if (t == b)
+		{
+			res = _atomic_cas_i64(&deque->top, t, t + 1);
+			_atomic_store_i64(&deque->bottom, b + 1);
+		}
+	}
+	else
+		_atomic_store_i64(&deque->bottom, b + 1);
+
+	return res;
+}
+
+// Sets retry when the task was lost against another thread, the deque may not be empty
+static b8 _task_deque_steal(TaskDeque *deque, TaskData *task, b8 *retry)
+{
+	i64 t = _atomic_load_i64(&deque->top);
+	_atomic_fence();
+	i64 b = _atomic_load_i64(&deque->bottom);
+
+	if (t < b)
+	{
+		*task = deque->tasks[t & (TASK_DEQUE_SIZE - 1)];
+
+		if (_atomic_cas_i64(&deque->top, t, t + 1))
+			return TRUE;
+
+		*retry = TRUE;
+	}
+
+	return FALSE;
+}
+
+///////////////////////////// SCHEDULER ////////////////////////////
+
+SV_INLINE void _task_count_dispatched(u32 count)
+{
+	TaskThreadData *worker = task_worker;
+
+	if (worker)
+		_atomic_store_u32(&worker->dispatched, worker->dispatched + count);
+	else
+		_atomic_add_u32(&task_system->external_dispatched, count);
+}
+
+static void _task_graph_node_retain(void *node, u32 count);
+static void _task_graph_node_release(void *node);
+static void _task_context_fire_watchers(TaskContext *context);
+
+// Set in the completed count when a task graph node waits for the context
+#define TASK_CONTEXT_WATCHED 0x80000000u
+
+SV_INLINE void _task_context_dispatch(TaskContext *context, u32 count)
+{
+	// The node is counted first, it can't be released before the task is counted
+	if (context->node != NULL)
+		_task_graph_node_retain(context->node, count);
+
+	_atomic_add_u32(&context->dispatched, count);
+}
+
+static void _task_notify_waiters(b8 drained)
+{
+	// Pairs with the fence of the waiting thread, either it sees the completion or we see it waiting
+	_atomic_fence();
+
+	if (_atomic_load_u32(&task_system->waiting_threads) == 0)
+		return;
+
+	if (drained || _atomic_load_u32(&task_system->global_waiters))
+	{
+		_atomic_add_u32(&task_system->wait_signal, 1);
+		os_futex_wake(&task_system->wait_signal, TRUE);
+	}
+}
+
+SV_INLINE void _task_context_complete(TaskContext *context)
+{
+	// Once the completion lands the waiter can return and the context can be out of scope, only the locals are used after it
+	void *node = context->node;
+	u32 dispatched = _atomic_load_u32(&context->dispatched);
+
+	u32 completed = _atomic_add_u32((volatile u32 *)&context->completed, 1);
+
+	// A watched context is alive until its watchers are fired, the count is read again once the completion landed.
+	// The cas clears the flag only if no completion came after this one, so the watchers are fired once
+	if (completed & TASK_CONTEXT_WATCHED)
+	{
+		if ((completed & ~TASK_CONTEXT_WATCHED) == _atomic_load_u32(&context->dispatched) &&
+			_atomic_cas_u32((volatile u32 *)&context->completed, completed, completed & ~TASK_CONTEXT_WATCHED))
+			_task_context_fire_watchers(context);
+	}
+
+	if (node != NULL)
+		_task_graph_node_release(node);
+
+	// The count read before can be behind if a running task dispatched meanwhile, the wake can be spurious but never missed
+	_task_notify_waiters((completed & ~TASK_CONTEXT_WATCHED) >= dispatched);
+}
+
+SV_INLINE void _task_count_completed()
+{
+	TaskThreadData *worker = task_worker;
+
+	if (worker)
+		_atomic_store_u32(&worker->completed, worker->completed + 1);
+	else
+		_atomic_add_u32(&task_system->external_completed, 1);
+
+	_task_notify_waiters(FALSE);
+}
+
+SV_INLINE void _task_lane_counters_add(TaskLaneCounters *counters, f64 latency)
+{
+	counters->executed++;
+	counters->latency_sum += latency;
+	counters->latency_max = SV_MAX(counters->latency_max, latency);
+}
+
+static void _task_lane_record(u32 priority, f64 latency)
+{
+	TaskThreadData *worker = task_worker;
+	u32 epoch = _atomic_load_u32(&task_system->stats_epoch);
+
+	if (worker)
+	{
+		if (worker->stats_epoch != epoch)
+		{
+			memory_zero(worker->lanes, sizeof(worker->lanes));
+			worker->stats_epoch = epoch;
+		}
+
+		_task_lane_counters_add(worker->lanes + priority, latency);
+
+		worker->stats.wait_time += latency;
+		worker->stats.wait_max = SV_MAX(worker->stats.wait_max, latency);
+	}
+	else
+	{
+		while (!_atomic_cas_u32(&task_system->external_lanes_lock, 0, 1))
+			_cpu_relax();
+
+		_task_lane_counters_add(task_system->external_lanes + priority, latency);
+
+		_atomic_store_u32(&task_system->external_lanes_lock, 0);
+	}
+}
+
+// Takes a slot of a lane with worker limit, the nested tasks of the same lane reuse it
+SV_INLINE b8 _task_lane_acquire(TaskThreadData *worker, u32 priority, b8 *slot)
+{
+	*slot = FALSE;
+
+	u32 limit = _atomic_load_u32(&task_system->lane_limit[priority]);
+
+	if (worker == NULL || limit == 0 || worker->lane_depth[priority])
+		return TRUE;
+
+	volatile u32 *active = &task_system->lane_active[priority];
+	u32 count = _atomic_load_u32(active);
+
+	while (count < limit)
+	{
+		if (_atomic_cas_u32(active, count, count + 1))
+		{
+			*slot = TRUE;
+			return TRUE;
+		}
+
+		count = _atomic_load_u32(active);
+	}
+
+	return FALSE;
+}
+
+SV_INLINE void _task_lane_release(u32 priority, b8 slot)
+{
+	if (slot)
+		_atomic_add_u32(&task_system->lane_active[priority], (u32)-1);
+}
+
+static void _task_execute(TaskData *task)
+{
+	// Task function
+	if (task->type == 1)
+	{
+		assert(task->fn != NULL);
+
+		TaskThreadData *worker = task_worker;
+		u32 priority = task->priority;
+
+		_task_lane_record(priority, timer_now() - task->dispatch_time);
+
+		if (worker)
+		{
+			worker->lane_depth[priority]++;
+			worker->stats.executed++;
+		}
+
+		TaskFn fn = task->fn;
+		fn(task->user_data);
+
+		if (worker)
+			worker->lane_depth[priority]--;
+
+		_task_lane_release(priority, task->lane_slot);
+
+		_task_count_completed();
+		if (task->context != NULL)
+			_task_context_complete(task->context);
+	}
+	// Reserve thread
+	else if (task->type == 2)
+	{
+		TaskReserveData reserve;
+		memory_copy(&reserve, task->user_data, sizeof(TaskReserveData));
+
+		_task_count_completed();
+		if (task_worker)
+			task_worker->stats.executed++;
+		_atomic_add_u32(&task_system->reserved_threads, 1);
+		_atomic_store_u32(reserve.started, TRUE);
+		os_futex_wake(reserve.started, TRUE);
+
+		ThreadMainFn fn = task->fn;
+		fn(reserve.main_data);
+
+		if (task->context != NULL)
+			_task_context_complete(task->context);
+		_atomic_add_u32(&task_system->reserved_threads, (u32)-1);
+		os_futex_wake(&task_system->reserved_threads, TRUE);
+	}
+}
+
+static b8 _task_find_in_lane(TaskThreadData *worker, u32 priority, TaskData *task)
+{
+	if (worker != NULL && _task_deque_pop(worker->deques + priority, task))
+		return TRUE;
+
+	if (mpmc_queue_pop(task_system->queues + priority, task))
+		return TRUE;
+
+	u32 count = task_system->thread_count;
+	b8 retry = TRUE;
+
+	// With several NUMA nodes the workers steal from their own node first, the stolen task data is closer
+	u32 pass_count = (worker != NULL && task_system->numa_node_count > 1) ? 2 : 1;
+
+	while (retry)
+	{
+		retry = FALSE;
+		u32 offset = _task_random();
+
+		foreach (i, count * pass_count)
+		{
+			TaskThreadData *victim = task_system->threads + ((offset + i) % count);
+
+			if (victim == worker)
+				continue;
+
+			if (pass_count > 1 && (victim->numa_node == worker->numa_node) != (i < count))
+				continue;
+
+			b8 lost = FALSE;
+			b8 stolen = _task_deque_steal(victim->deques + priority, task, &lost);
+
+			if (worker != NULL && (stolen || lost))
+			{
+				worker->stats.steal_attempts++;
+				if (stolen)
+					worker->stats.steal_successes++;
+			}
+
+			if (stolen)
+				return TRUE;
+
+			retry |= lost;
+		}
+	}
+
+	return FALSE;
+}
+
+// Looks for work lane by lane, in the own deque, then in the shared queue and then stealing from the other workers.
+// The reserved threads are only taken from the worker loop, a helping thread would never come back.
+static b8 _task_find(TaskData *task, b8 reserve)
+{
+	TaskThreadData *worker = task_worker;
+
+	foreach (priority, TaskPriority_MaxEnum)
+	{
+		if (reserve && priority == TaskPriority_Normal && mpmc_queue_pop(&task_system->reserve_queue, task))
+			return TRUE;
+
+		b8 slot;
+
+		if (!_task_lane_acquire(worker, priority, &slot))
+			continue;
+
+		if (_task_find_in_lane(worker, priority, task))
+		{
+			task->lane_slot = slot;
+			return TRUE;
+		}
+
+		_task_lane_release(priority, slot);
+	}
+
+	return FALSE;
+}
+
+static void _task_wake()
+{
+	// Pairs with the fence of the sleeping worker, either it sees the new task or we see it sleeping
+	_atomic_fence();
+
+	if (_atomic_load_u32(&task_system->sleeping_threads))
+	{
+		_atomic_add_u32(&task_system->wake_signal, 1);
+		os_futex_wake(&task_system->wake_signal, FALSE);
+	}
+	// Every worker is busy, the blocked waiters can help
+	else if (_atomic_load_u32(&task_system->waiting_threads))
+	{
+		_atomic_add_u32(&task_system->wait_signal, 1);
+		os_futex_wake(&task_system->wait_signal, TRUE);
+	}
+}
+
+// Top level execution of a worker, the time between tasks is idle time
+SV_INLINE void _task_worker_run(TaskThreadData *thread, TaskData *task, f64 *idle_begin)
+{
+	f64 begin = timer_now();
+	_task_execute(task);
+	f64 end = timer_now();
+
+	thread->stats.idle_time += begin - *idle_begin;
+	thread->stats.busy_time += end - begin;
+	*idle_begin = end;
+}
+
+static i32 task_thread(void *arg)
+{
+	TaskThreadData *thread = arg;
+	task_worker = thread;
+
+	TaskData task;
+	f64 idle_begin = timer_now();
+
+	while (task_system->running)
+	{
+		if (_task_find(&task, TRUE))
+		{
+			_task_worker_run(thread, &task, &idle_begin);
+			continue;
+		}
+
+		_atomic_add_u32(&task_system->sleeping_threads, 1);
+		_atomic_fence();
+
+		u32 signal = _atomic_load_u32(&task_system->wake_signal);
+
+		if (_task_find(&task, TRUE))
+		{
+			_atomic_add_u32(&task_system->sleeping_threads, (u32)-1);
+			_task_worker_run(thread, &task, &idle_begin);
+			continue;
+		}
+
+		if (task_system->running)
+			os_futex_wait(&task_system->wake_signal, signal);
+
+		_atomic_add_u32(&task_system->sleeping_threads, (u32)-1);
+	}
+
+	return 0;
+}
+
+static void _task_submit(const TaskData *task)
+{
+	TaskThreadData *worker = task_worker;
+
+	// The workers keep their tasks local, the rest of threads share the queue
+	if (worker != NULL && _task_deque_push(worker->deques + task->priority, task))
+	{
+		TaskDeque *deque = worker->deques + task->priority;
+		u32 depth = (u32)(deque->bottom - _atomic_load_i64(&deque->top));
+		worker->stats.queue_high_water = SV_MAX(worker->stats.queue_high_water, depth);
+	}
+	else
+	{
+		while (!mpmc_queue_push(task_system->queues + task->priority, task))
+		{
+			// The queue is full, make room running queued tasks in this thread
+			TaskData other;
+
+			if (_task_find(&other, FALSE))
+				_task_execute(&other);
+			else
+				thread_yield();
+		}
+	}
+
+	_task_wake();
+}
+
+// Order in which the processors receive workers
+static b8 _task_cpu_before(const CpuInfo *a, const CpuInfo *b, TaskPlacement placement)
+{
+	if (placement != TaskPlacement_Compact)
+	{
+		if (a->smt_index != b->smt_index)
+			return a->smt_index < b->smt_index;
+
+		if (a->performance != b->performance)
+			return a->performance > b->performance;
+	}
+
+	return a->id < b->id;
+}
+
+b8 _task_initialize(const PlatformInitializeDesc *desc)
+{
+	task_system = memory_allocate(sizeof(TaskSystemData));
+	task_system->running = TRUE;
+
+	foreach (priority, TaskPriority_MaxEnum)
+		mpmc_queue_init(task_system->queues + priority, sizeof(TaskData), TASK_QUEUE_SIZE);
+	mpmc_queue_init(&task_system->reserve_queue, sizeof(TaskData), TASK_RESERVE_QUEUE_SIZE);
+
+	TaskPlacement placement = desc->task.placement;
+
+	u32 cpu_count;
+	const CpuInfo *cpus = cpu_topology(&cpu_count);
+
+	// Available processors sorted by placement order
+	const CpuInfo **order = memory_allocate(sizeof(CpuInfo *) * SV_MAX(cpu_count, 1));
+	u32 order_count = 0;
+
+	foreach (i, cpu_count)
+	{
+		const CpuInfo *cpu = cpus + i;
+
+		if (cpu_mask_test(&desc->task.exclude, cpu->id))
+			continue;
+
+		u32 j = order_count++;
+
+		while (j > 0 && _task_cpu_before(cpu, order[j - 1], placement))
+		{
+			order[j] = order[j - 1];
+			--j;
+		}
+
+		order[j] = cpu;
+	}
+
+	if (order_count == 0)
+	{
+		SV_LOG_WARNING("Every processor is excluded, the task workers won't be pinned\n");
+		placement = TaskPlacement_None;
+	}
+
+	// The first processor is left for the main thread, the task system is initialized from it
+	u32 first = (order_count > 1) ? 1 : 0;
+	u32 slot_count = order_count - first;
+
+	if (placement != TaskPlacement_None)
+	{
+		CpuMask mask;
+		memory_zero(&mask, sizeof(mask));
+		cpu_mask_set(&mask, order[0]->id);
+
+		if (!thread_set_affinity(os_thread_current(), &mask))
+			SV_LOG_WARNING("Can't set the affinity of the main thread\n");
+	}
+
+	u32 thread_count = desc->task.worker_count;
+
+	if (thread_count == 0)
+	{
+		u32 available = order_count ? order_count : cpu_count;
+		thread_count = SV_MAX(available, 2) - 1;
+	}
+
+	task_system->threads = memory_allocate(sizeof(TaskThreadData) * thread_count);
+	task_system->thread_count = thread_count;
+	task_system->numa_node_count = (placement == TaskPlacement_None) ? 1 : cpu_numa_node_count();
+
+	foreach (t, thread_count)
+	{
+		TaskThreadData *thread_data = task_system->threads + t;
+		thread_data->id = t;
+
+		// More workers than processors share them in the same order
+		const CpuInfo *cpu = (placement == TaskPlacement_None) ? NULL : order[first + (t % slot_count)];
+		thread_data->numa_node = cpu ? cpu->numa_node : 0;
+
+		thread_data->thread = thread_create(task_thread, thread_data);
+
+		if (thread_data->thread == 0)
+		{
+			SV_LOG_ERROR("Can't create task thread\n");
+			task_system->thread_count = t;
+			memory_free(order);
+			return FALSE;
+		}
+
+		// Config thread
+		{
+			char name[200];
+			string_copy(name, "task_", 200);
+
+			char id_str[30];
+			string_from_u32(id_str, t);
+
+			string_append(name, id_str, 200);
+
+			thread_configure(thread_data->thread, name, 0, ThreadPrority_Highest);
+		}
+
+		if (cpu)
+		{
+			CpuMask mask;
+			memory_zero(&mask, sizeof(mask));
+
+			if (placement == TaskPlacement_NumaNode)
+			{
+				foreach (i, order_count)
+				{
+					if (order[i]->numa_node == cpu->numa_node)
+						cpu_mask_set(&mask, order[i]->id);
+				}
+			}
+			else
+				cpu_mask_set(&mask, cpu->id);
+
+			if (!thread_set_affinity(thread_data->thread, &mask))
+				SV_LOG_WARNING("Can't set the affinity of the task thread %u\n", t);
+		}
+	}
+
+	SV_LOG_INFO("Task system with %u workers, %u processors available, %u NUMA nodes\n", thread_count, order_count, task_system->numa_node_count);
+
+	memory_free(order);
+
+	return TRUE;
+}
+
+void _task_close()
+{
+	if (task_system == NULL)
+		return;
+
+	task_join();
+
+	task_system->running = FALSE;
+
+	_atomic_add_u32(&task_system->wake_signal, 1);
+	os_futex_wake(&task_system->wake_signal, TRUE);
+
+	foreach (i, task_system->thread_count)
+		thread_wait(task_system->threads[i].thread);
+
+	foreach (priority, TaskPriority_MaxEnum)
+		mpmc_queue_close(task_system->queues + priority);
+	mpmc_queue_close(&task_system->reserve_queue);
+	memory_free(task_system->threads);
+	memory_free(task_system);
+	task_system = NULL;
+}
+
+void task_dispatch(TaskDesc *tasks, u32 task_count, TaskContext *context)
+{
+	task_dispatch_priority(tasks, task_count, context, TaskPriority_Normal);
+}
+
+void task_dispatch_priority(TaskDesc *tasks, u32 task_count, TaskContext *context, TaskPriority priority)
+{
+	assert(priority < TaskPriority_MaxEnum);
+
+	if (context)
+	{
+		_task_context_dispatch(context, task_count);
+	}
+
+	_task_count_dispatched(task_count);
+
+	f64 now = timer_now();
+
+	foreach (i, task_count)
+	{
+		TaskDesc desc = tasks[i];
+
+		assert_title(desc.fn != NULL, "Null task function");
+		assert_title(desc.size <= TASK_DATA_SIZE, "The task data size is too large");
+
+		TaskData task;
+		task.fn = desc.fn;
+		task.context = context;
+		if (desc.data)
+			memory_copy(task.user_data, desc.data, desc.size);
+		task.dispatch_time = now;
+		task.type = 1;
+		task.priority = priority;
+
+		_task_submit(&task);
+	}
+}
+
+void task_reserve_thread(ThreadMainFn main_fn, void *main_data, TaskContext *context)
+{
+	if (context != NULL)
+		_task_context_dispatch(context, 1);
+
+	_task_count_dispatched(1);
+
+	volatile u32 started = FALSE;
+
+	TaskReserveData reserve;
+	reserve.main_data = main_data;
+	reserve.started = &started;
+
+	TaskData task;
+	task.fn = main_fn;
+	task.context = context;
+	memory_copy(task.user_data, &reserve, sizeof(TaskReserveData));
+	task.dispatch_time = timer_now();
+	task.type = 2;
+	task.priority = TaskPriority_Normal;
+
+	while (!mpmc_queue_push(&task_system->reserve_queue, &task))
+		thread_yield();
+
+	_task_wake();
+
+	while (!_atomic_load_u32(&started))
+		os_futex_wait(&started, FALSE);
+}
+
+void task_join()
+{
+	task_wait(NULL);
+
+	u32 reserved;
+
+	while ((reserved = _atomic_load_u32(&task_system->reserved_threads)) != 0)
+	{
+		os_futex_wait(&task_system->reserved_threads, reserved);
+	}
+}
+
+b8 _task_help()
+{
+	TaskData task;
+
+	if (!_task_find(&task, FALSE))
+		return FALSE;
+
+	_task_execute(&task);
+	return TRUE;
+}
+
+void task_wait(TaskContext *context)
+{
+	TaskData task;
+	u32 spin = 0;
+
+	while (task_running(context))
+	{
+		if (_task_find(&task, FALSE))
+		{
+			_task_execute(&task);
+			spin = 0;
+			continue;
+		}
+
+		if (spin < TASK_WAIT_SPIN)
+		{
+			++spin;
+			_cpu_relax();
+			continue;
+		}
+
+		// Nothing to help with, sleep until some context is drained or a busy system publishes new work
+		_atomic_add_u32(&task_system->waiting_threads, 1);
+		if (context == NULL)
+			_atomic_add_u32(&task_system->global_waiters, 1);
+		_atomic_fence();
+
+		u32 signal = _atomic_load_u32(&task_system->wait_signal);
+
+		b8 found = _task_find(&task, FALSE);
+
+		if (!found && task_running(context))
+			os_futex_wait(&task_system->wait_signal, signal);
+
+		if (context == NULL)
+			_atomic_add_u32(&task_system->global_waiters, (u32)-1);
+		_atomic_add_u32(&task_system->waiting_threads, (u32)-1);
+
+		if (found)
+			_task_execute(&task);
+
+		spin = 0;
+	}
+}
+
+b8 task_running(TaskContext *context)
+{
+	if (context)
+	{
+		return ((u32)context->completed & ~TASK_CONTEXT_WATCHED) < context->dispatched;
+	}
+	else
+	{
+		// The completed tasks are read first, a task is always counted as dispatched before it can complete
+		u32 completed = _atomic_load_u32(&task_system->external_completed);
+		foreach (i, task_system->thread_count)
+			completed += _atomic_load_u32(&task_system->threads[i].completed);
+
+		u32 dispatched = _atomic_load_u32(&task_system->external_dispatched);
+		foreach (i, task_system->thread_count)
+			dispatched += _atomic_load_u32(&task_system->threads[i].dispatched);
+
+		return completed != dispatched;
+	}
+}
+
+void task_lane_worker_limit(TaskPriority priority, u32 limit)
+{
+	assert(priority < TaskPriority_MaxEnum);
+	_atomic_store_u32(&task_system->lane_limit[priority], limit ? SV_MAX(limit, 1) : 0);
+}
+
+TaskLaneStats task_lane_stats(TaskPriority priority)
+{
+	assert(priority < TaskPriority_MaxEnum);
+
+	TaskLaneCounters counters = task_system->external_lanes[priority];
+	u32 epoch = _atomic_load_u32(&task_system->stats_epoch);
+
+	foreach (i, task_system->thread_count)
+	{
+		TaskThreadData *worker = task_system->threads + i;
+
+		if (worker->stats_epoch != epoch)
+			continue;
+
+		TaskLaneCounters c = worker->lanes[priority];
+		counters.executed += c.executed;
+		counters.latency_sum += c.latency_sum;
+		counters.latency_max = SV_MAX(counters.latency_max, c.latency_max);
+	}
+
+	TaskLaneStats stats;
+	stats.executed = counters.executed;
+	stats.latency_avg = counters.executed ? (counters.latency_sum / (f64)counters.executed) : 0.0;
+	stats.latency_max = counters.latency_max;
+	return stats;
+}
+
+void task_lane_stats_reset()
+{
+	// The workers reset their own counters when they see the new epoch
+	_atomic_add_u32(&task_system->stats_epoch, 1);
+
+	while (!_atomic_cas_u32(&task_system->external_lanes_lock, 0, 1))
+		_cpu_relax();
+
+	memory_zero(task_system->external_lanes, sizeof(task_system->external_lanes));
+
+	_atomic_store_u32(&task_system->external_lanes_lock, 0);
+}
+
+void _task_context_retain(TaskContext *context)
+{
+	if (context)
+		_task_context_dispatch(context, 1);
+
+	_task_count_dispatched(1);
+}
+
+void _task_context_release(TaskContext *context)
+{
+	_task_count_completed();
+
+	if (context)
+		_task_context_complete(context);
+}
+
+u32 task_worker_count()
+{
+	return task_system->thread_count;
+}
+
+TaskWorkerStats task_worker_stats(u32 worker)
+{
+	assert(worker < task_system->thread_count);
+	return task_system->threads[worker].stats;
+}
+
+///////////////////////////// PARALLEL FOR ////////////////////////////
+
+#define TASK_RANGE_MODE_FOR 0
+#define TASK_RANGE_MODE_FOREACH 1
+#define TASK_RANGE_MODE_REDUCE 2
+
+// The user casts the results to its own type, aligned like any scalar or pointer
+typedef union
+{
+	b8 data[TASK_DATA_SIZE];
+	u64 _u64;
+	f64 _f64;
+	void *_ptr;
+} TaskReduceValue;
+
+typedef struct
+{
+
+	TaskReduceFn fn;
+	TaskJoinFn join_fn;
+	void *data;
+	const void *identity;
+	u32 result_size;
+
+	// One partial result per worker plus one shared by the rest of threads
+	u8 *partials;
+	u32 partial_stride;
+	volatile u32 external_lock;
+
+} TaskReduceState;
+
+typedef struct
+{
+
+	void *fn;
+	void *data;
+	TaskContext *context;
+	u32 begin;
+	u32 end;
+	u32 grain;
+	u32 splits;
+	u32 owner; // Worker id + 1 of the dispatcher, 0 for the rest of threads
+	u8 mode;
+
+} TaskRangeData;
+
+SV_INLINE u32 _task_worker_owner()
+{
+	return task_worker ? (task_worker->id + 1) : 0;
+}
+
+// Split budget given to the ranges that start in a new thread
+SV_INLINE u32 _task_split_depth()
+{
+	u32 depth = 0;
+	u32 n = task_system->thread_count + 1;
+
+	while (n > 1)
+	{
+		n = (n + 1) / 2;
+		++depth;
+	}
+
+	return depth + 2;
+}
+
+static void _task_range_run(TaskRangeData *range, u32 begin, u32 end)
+{
+	switch (range->mode)
+	{
+
+	case TASK_RANGE_MODE_FOR:
+	{
+		TaskRangeFn fn = range->fn;
+		fn(begin, end, range->data);
+	}
+	break;
+
+	case TASK_RANGE_MODE_FOREACH:
+	{
+		TaskFn fn = range->fn;
+
+		for (u32 i = begin; i < end; ++i)
+		{
+			ForeachTask task;
+			task.data = range->data;
+			task.index = i;
+			fn(&task);
+		}
+	}
+	break;
+
+	case TASK_RANGE_MODE_REDUCE:
+	{
+		TaskReduceState *state = range->data;
+
+		TaskReduceValue partial;
+		memory_copy(partial.data, state->identity, state->result_size);
+
+		state->fn(begin, end, state->data, partial.data);
+
+		TaskThreadData *worker = task_worker;
+
+		if (worker)
+		{
+			state->join_fn(state->partials + state->partial_stride * worker->id, partial.data);
+		}
+		else
+		{
+			while (!_atomic_cas_u32(&state->external_lock, 0, 1))
+				_cpu_relax();
+
+			state->join_fn(state->partials + state->partial_stride * task_system->thread_count, partial.data);
+
+			_atomic_store_u32(&state->external_lock, 0);
+		}
+	}
+	break;
+
+	}
+}
+
+static void _task_range_dispatch(const TaskRangeData *range);
+
+static void task_range(void *arg)
+{
+	TaskRangeData range;
+	memory_copy(&range, arg, sizeof(TaskRangeData));
+
+	// Stolen ranges are subdivided again, the thief may be the first of many idle threads
+	u32 owner = _task_worker_owner();
+
+	if (range.owner != owner)
+	{
+		range.splits = SV_MAX(range.splits, _task_split_depth());
+		range.owner = owner;
+	}
+
+	u32 begin = range.begin;
+	u32 end = range.end;
+
+	while (begin < end)
+	{
+		// Give the upper half away while there is budget or some thread is waiting for work
+		while (end - begin > range.grain && (range.splits || _atomic_load_u32(&task_system->sleeping_threads)))
+		{
+			u32 mid = begin + (end - begin) / 2;
+
+			if (range.splits)
+				--range.splits;
+
+			TaskRangeData child = range;
+			child.begin = mid;
+			child.end = end;
+			_task_range_dispatch(&child);
+
+			end = mid;
+		}
+
+		u32 chunk_end = SV_MIN(begin + range.grain, end);
+		_task_range_run(&range, begin, chunk_end);
+		begin = chunk_end;
+	}
+}
+
+static void _task_range_dispatch(const TaskRangeData *range)
+{
+	TaskDesc desc;
+	desc.fn = task_range;
+	desc.data = range;
+	desc.size = sizeof(TaskRangeData);
+
+	task_dispatch(&desc, 1, range->context);
+}
+
+static void _task_range_begin(u32 begin, u32 end, u32 grain, void *fn, void *data, u8 mode, TaskContext *context)
+{
+	if (begin >= end)
+		return;
+
+	if (grain == 0)
+	{
+		grain = (end - begin) / ((task_system->thread_count + 1) * 8);
+		grain = SV_MAX(grain, 1);
+	}
+
+	TaskRangeData range;
+	range.fn = fn;
+	range.data = data;
+	range.context = context;
+	range.begin = begin;
+	range.end = end;
+	range.grain = grain;
+	range.splits = _task_split_depth();
+	range.owner = _task_worker_owner();
+	range.mode = mode;
+
+	_task_range_dispatch(&range);
+}
+
+void task_parallel_for(u32 begin, u32 end, u32 grain, TaskRangeFn fn, void *data, TaskContext *context)
+{
+	assert_title(fn != NULL, "Null task function");
+	_task_range_begin(begin, end, grain, fn, data, TASK_RANGE_MODE_FOR, context);
+}
+
+void task_foreach(TaskFn fn, u32 count, void *data, TaskContext *context)
+{
+	assert_title(fn != NULL, "Null task function");
+	_task_range_begin(0, count, 0, fn, data, TASK_RANGE_MODE_FOREACH, context);
+}
+
+void task_parallel_reduce(u32 begin, u32 end, u32 grain, TaskReduceFn fn, TaskJoinFn join_fn, void *data, void *result, u32 result_size)
+{
+	assert_title(fn != NULL && join_fn != NULL, "Null task function");
+	assert_title(result_size <= TASK_DATA_SIZE, "The reduce result size is too large");
+
+	if (begin >= end)
+		return;
+
+	TaskReduceValue identity;
+	memory_copy(identity.data, result, result_size);
+
+	TaskReduceState state;
+	memory_zero(&state, sizeof(state));
+	state.fn = fn;
+	state.join_fn = join_fn;
+	state.data = data;
+	state.identity = identity.data;
+	state.result_size = result_size;
+
+	// Padded to avoid false sharing between the workers
+	state.partial_stride = (result_size + TASK_CACHE_LINE - 1) & ~(TASK_CACHE_LINE - 1);
+
+	u32 partial_count = task_system->thread_count + 1;
+
+	Scratch scratch = scratch_begin();
+	state.partials = linear_allocator_push_aligned(scratch.allocator, state.partial_stride * partial_count, TASK_CACHE_LINE);
+
+	foreach (i, partial_count)
+		memory_copy(state.partials + state.partial_stride * i, identity.data, result_size);
+
+	TaskContext ctx = {0};
+	_task_range_begin(begin, end, grain, NULL, &state, TASK_RANGE_MODE_REDUCE, &ctx);
+	task_wait(&ctx);
+
+	foreach (i, partial_count)
+		join_fn(result, state.partials + state.partial_stride * i);
+
+	scratch_end(scratch);
+}
+
+///////////////////////////// PARALLEL SORT ////////////////////////////
+
+#define TASK_SORT_MIN_CHUNK 2048
+
+typedef struct
+{
+	u8 *src;
+	u8 *dst;
+	u32 count;
+	u32 stride;
+	u32 width; // Elements per sorted run
+	LessThanFn fn;
+} TaskSortState;
+
+static void _task_sort_runs(u32 begin, u32 end, void *data)
+{
+	TaskSortState *state = (TaskSortState *)data;
+
+	for (u32 i = begin; i < end; ++i)
+	{
+		u32 first = i * state->width;
+		u32 count = SV_MIN(state->width, state->count - first);
+		array_sort(state->src + (size_t)first * state->stride, count, state->stride, state->fn);
+	}
+}
+
+// Each index merges two consecutive runs from src to dst
+static void _task_sort_merge(u32 begin, u32 end, void *data)
+{
+	TaskSortState *state = (TaskSortState *)data;
+	u32 stride = state->stride;
+
+	for (u32 i = begin; i < end; ++i)
+	{
+		u32 first = i * state->width * 2u;
+		u32 mid = SV_MIN(first + state->width, state->count);
+		u32 last = SV_MIN(mid + state->width, state->count);
+
+		u8 *it0 = state->src + (size_t)first * stride;
+		u8 *end0 = state->src + (size_t)mid * stride;
+		u8 *it1 = end0;
+		u8 *end1 = state->src + (size_t)last * stride;
+		u8 *dst = state->dst + (size_t)first * stride;
+
+		while (it0 != end0 && it1 != end1)
+		{
+			// The left run wins the ties
+			if (state->fn(it1, it0))
+			{
+				memory_copy(dst, it1, stride);
+				it1 += stride;
+			}
+			else
+			{
+				memory_copy(dst, it0, stride);
+				it0 += stride;
+			}
+			dst += stride;
+		}
+
+		memory_copy(dst, it0, end0 - it0);
+		dst += end0 - it0;
+		memory_copy(dst, it1, end1 - it1);
+	}
+}
+
+void task_parallel_sort(void *data, u32 count, u32 stride, void *fn)
+{
+	u32 workers = (task_system != NULL) ? (task_system->thread_count + 1u) : 1u;
+
+	u32 run_count = 1u;
+	while (run_count < workers && count / (run_count * 2u) >= TASK_SORT_MIN_CHUNK)
+		run_count *= 2u;
+
+	if (run_count == 1u)
+	{
+		array_sort(data, count, stride, fn);
+		return;
+	}
+
+	TaskSortState state;
+	state.src = (u8 *)data;
+	state.dst = (u8 *)memory_allocate_uninit((size_t)count * stride);
+	state.count = count;
+	state.stride = stride;
+	state.width = (count + run_count - 1u) / run_count;
+	state.fn = (LessThanFn)fn;
+
+	{
+		TaskContext ctx = {0};
+		task_parallel_for(0, run_count, 1, _task_sort_runs, &state, &ctx);
+		task_wait(&ctx);
+	}
+
+	// The merge passes ping pong between the array and the temporal buffer
+	while (state.width < count)
+	{
+		u32 pairs = (count + state.width * 2u - 1u) / (state.width * 2u);
+
+		TaskContext ctx = {0};
+		task_parallel_for(0, pairs, 1, _task_sort_merge, &state, &ctx);
+		task_wait(&ctx);
+
+		u8 *aux = state.src;
+		state.src = state.dst;
+		state.dst = aux;
+		state.width *= 2u;
+	}
+
+	if (state.src != data)
+	{
+		memory_copy(data, state.src, (size_t)count * stride);
+		memory_free(state.src);
+	}
+	else
+		memory_free(state.dst);
+}
+
+#define TASK_RADIX_MIN_CHUNK 65536
+
+typedef struct
+{
+	const void *data;
+	u32 count;
+	u32 stride;
+	u32 key_offset;
+	u32 key_size;
+	b8 float_key;
+	u32 chunk_size;
+	u32 *histograms; // One set per chunk
+} TaskRadixState;
+
+static void _task_radix_histogram(u32 begin, u32 end, void *data)
+{
+	TaskRadixState *state = (TaskRadixState *)data;
+
+	for (u32 i = begin; i < end; ++i)
+	{
+		u32 first = i * state->chunk_size;
+		u32 last = SV_MIN(first + state->chunk_size, state->count);
+		_array_radix_histogram(state->data, first, last, state->stride, state->key_offset, state->key_size, state->float_key, state->histograms + i * state->key_size * 256u);
+	}
+}
+
+static void _task_radix_sort(void *data, u32 count, u32 stride, u32 key_offset, u32 key_size, b8 float_key, void *scratch)
+{
+	if (data == NULL || count < 2u)
+		return;
+
+	u32 workers = (task_system != NULL) ? (task_system->thread_count + 1u) : 1u;
+	u32 chunk_count = SV_MIN(workers, count / TASK_RADIX_MIN_CHUNK);
+	chunk_count = SV_MAX(chunk_count, 1u);
+
+	u32 histogram_count = key_size * 256u;
+
+	Scratch temp = scratch_begin();
+
+	TaskRadixState state;
+	state.data = data;
+	state.count = count;
+	state.stride = stride;
+	state.key_offset = key_offset;
+	state.key_size = key_size;
+	state.float_key = float_key;
+	state.chunk_size = (count + chunk_count - 1u) / chunk_count;
+	state.histograms = scratch_push_array(temp, u32, histogram_count * chunk_count);
+
+	if (chunk_count == 1u)
+	{
+		_task_radix_histogram(0, 1, &state);
+	}
+	else
+	{
+		TaskContext ctx = {0};
+		task_parallel_for(0, chunk_count, 1, _task_radix_histogram, &state, &ctx);
+		task_wait(&ctx);
+
+		for (u32 i = 1; i < chunk_count; ++i)
+		{
+			foreach (j, histogram_count)
+				state.histograms[j] += state.histograms[i * histogram_count + j];
+		}
+	}
+
+	_array_radix_scatter(data, count, stride, key_offset, key_size, float_key, scratch, state.histograms);
+
+	scratch_end(temp);
+}
+
+void task_parallel_radix_sort_u32(void *data, u32 count, u32 stride, u32 key_offset, void *scratch)
+{
+	_task_radix_sort(data, count, stride, key_offset, 4u, FALSE, scratch);
+}
+
+void task_parallel_radix_sort_u64(void *data, u32 count, u32 stride, u32 key_offset, void *scratch)
+{
+	_task_radix_sort(data, count, stride, key_offset, 8u, FALSE, scratch);
+}
+
+void task_parallel_radix_sort_f32(void *data, u32 count, u32 stride, u32 key_offset, void *scratch)
+{
+	_task_radix_sort(data, count, stride, key_offset, 4u, TRUE, scratch);
+}
+
+///////////////////////////// TASK GRAPH ////////////////////////////
+
+// Linked in the context that the node waits for, the drained context dispatches the node like a predecessor
+typedef struct TaskContextWatcher
+{
+	struct TaskContextWatcher *next;
+	TaskContext *context;
+	void *node;
+} TaskContextWatcher;
+
+typedef struct
+{
+
+	TaskFn fn;
+	b8 data[TASK_DATA_SIZE];
+
+	// Owned by the node, the tasks dispatched with it delay the completion of the node
+	TaskContext context;
+
+	DynamicArray(u32) successors;
+	DynamicArray(TaskContextWatcher) wait_contexts;
+	u32 predecessor_count;
+
+	volatile u32 pending_predecessors;
+	// The node function plus the tasks dispatched with the node context
+	volatile u32 remaining;
+
+	struct TaskGraphData *graph;
+
+} TaskGraphNode;
+
+typedef struct TaskGraphData
+{
+
+	DynamicArray(TaskGraphNode *) nodes;
+
+	TaskContext *run_context;
+	volatile u32 pending_nodes;
+
+} TaskGraphData;
+
+SV_INLINE TaskGraphNode *_task_graph_node_get(TaskGraphData *graph, TaskNode node)
+{
+	return *(TaskGraphNode **)array_get(&graph->nodes, node);
+}
+
+static void task_graph_node(void *arg)
+{
+	TaskGraphNode *node = *(TaskGraphNode **)arg;
+
+	node->fn(node->data);
+
+	_task_graph_node_release(node);
+}
+
+static void _task_graph_node_dispatch(TaskGraphNode *node)
+{
+	TaskDesc desc;
+	desc.fn = task_graph_node;
+	desc.data = &node;
+	desc.size = sizeof(TaskGraphNode *);
+
+	task_dispatch(&desc, 1, NULL);
+}
+
+static void _task_graph_node_retain(void *node_, u32 count)
+{
+	TaskGraphNode *node = node_;
+	_atomic_add_u32(&node->remaining, count);
+}
+
+static void _task_graph_node_release(void *node_)
+{
+	TaskGraphNode *node = node_;
+
+	if (_atomic_add_u32(&node->remaining, (u32)-1) != 0)
+		return;
+
+	TaskGraphData *graph = node->graph;
+	TaskContext *run_context = graph->run_context;
+
+	// The successors are dispatched before completing the node, the run context never drains in between
+	foreach (i, node->successors.size)
+	{
+		u32 index = *(u32 *)array_get(&node->successors, i);
+		TaskGraphNode *successor = _task_graph_node_get(graph, index);
+
+		if (_atomic_add_u32(&successor->pending_predecessors, (u32)-1) == 0)
+			_task_graph_node_dispatch(successor);
+	}
+
+	_atomic_add_u32(&graph->pending_nodes, (u32)-1);
+
+	if (run_context != NULL)
+		_task_context_complete(run_context);
+}
+
+static void _task_context_fire_watchers(TaskContext *context)
+{
+	TaskContextWatcher *watcher = atomic_exchange_ptr(&context->watchers, NULL, MemoryOrder_SeqCst);
+
+	// The node can finish the graph once it's dispatched, the next watcher is read before
+	while (watcher != NULL)
+	{
+		TaskContextWatcher *next = watcher->next;
+		TaskGraphNode *node = watcher->node;
+
+		if (_atomic_add_u32(&node->pending_predecessors, (u32)-1) == 0)
+			_task_graph_node_dispatch(node);
+
+		watcher = next;
+	}
+}
+
+static void _task_context_watch(TaskContextWatcher *watcher)
+{
+	TaskContext *context = watcher->context;
+
+	void *head = atomic_load_ptr(&context->watchers, MemoryOrder_SeqCst);
+	do
+	{
+		watcher->next = head;
+	} while (!atomic_cas_ptr(&context->watchers, &head, watcher, MemoryOrder_SeqCst));
+
+	while (TRUE)
+	{
+		u32 completed = _atomic_load_u32((volatile u32 *)&context->completed);
+
+		// Drained, no completion will fire the watchers. The cas fails if a completion came meanwhile
+		if ((completed & ~TASK_CONTEXT_WATCHED) == _atomic_load_u32(&context->dispatched))
+		{
+			if (_atomic_cas_u32((volatile u32 *)&context->completed, completed, completed & ~TASK_CONTEXT_WATCHED))
+			{
+				_task_context_fire_watchers(context);
+				return;
+			}
+		}
+		else if (_atomic_cas_u32((volatile u32 *)&context->completed, completed, completed | TASK_CONTEXT_WATCHED))
+			return;
+	}
+}
+
+TaskGraph task_graph_create()
+{
+	TaskGraphData *graph = memory_allocate(sizeof(TaskGraphData));
+	graph->nodes = array_init(TaskGraphNode *, 2.f);
+	return (TaskGraph)graph;
+}
+
+void task_graph_destroy(TaskGraph graph_)
+{
+	TaskGraphData *graph = (TaskGraphData *)graph_;
+
+	if (graph == NULL)
+		return;
+
+	assert_title(graph->pending_nodes == 0, "Can't destroy a running task graph");
+
+	foreach (i, graph->nodes.size)
+	{
+		TaskGraphNode *node = _task_graph_node_get(graph, i);
+		array_close(&node->successors);
+		array_close(&node->wait_contexts);
+		memory_free(node);
+	}
+
+	array_close(&graph->nodes);
+	memory_free(graph);
+}
+
+TaskNode task_graph_add(TaskGraph graph_, TaskFn fn, const void *data, u32 size)
+{
+	TaskGraphData *graph = (TaskGraphData *)graph_;
+
+	assert_title(fn != NULL, "Null task function");
+	assert_title(size <= TASK_DATA_SIZE, "The task data size is too large");
+
+	TaskGraphNode *node = memory_allocate(sizeof(TaskGraphNode));
+	node->fn = fn;
+	if (data)
+		memory_copy(node->data, data, size);
+	node->context.node = node;
+	node->successors = array_init(u32, 2.f);
+	node->wait_contexts = array_init(TaskContextWatcher, 2.f);
+	node->graph = graph;
+
+	TaskNode index = graph->nodes.size;
+	array_push(&graph->nodes, node);
+
+	return index;
+}
+
+void task_graph_depend(TaskGraph graph_, TaskNode node_, TaskNode predecessor_)
+{
+	TaskGraphData *graph = (TaskGraphData *)graph_;
+
+	assert_title(predecessor_ < node_, "The predecessor must be added before the node");
+
+	TaskGraphNode *node = _task_graph_node_get(graph, node_);
+	TaskGraphNode *predecessor = _task_graph_node_get(graph, predecessor_);
+
+	array_push(&predecessor->successors, node_);
+	node->predecessor_count++;
+}
+
+void task_graph_depend_context(TaskGraph graph_, TaskNode node_, TaskContext *context)
+{
+	TaskGraphData *graph = (TaskGraphData *)graph_;
+	TaskGraphNode *node = _task_graph_node_get(graph, node_);
+
+	TaskContextWatcher *watcher = array_add(&node->wait_contexts);
+	watcher->context = context;
+	watcher->node = node;
+}
+
+TaskContext *task_graph_context(TaskGraph graph_, TaskNode node)
+{
+	TaskGraphData *graph = (TaskGraphData *)graph_;
+	return &_task_graph_node_get(graph, node)->context;
+}
+
+void *task_graph_data(TaskGraph graph_, TaskNode node)
+{
+	TaskGraphData *graph = (TaskGraphData *)graph_;
+	return _task_graph_node_get(graph, node)->data;
+}
+
+void task_graph_run(TaskGraph graph_, TaskContext *context)
+{
+	TaskGraphData *graph = (TaskGraphData *)graph_;
+
+	assert_title(_atomic_load_u32(&graph->pending_nodes) == 0, "The task graph is already running");
+
+	u32 node_count = graph->nodes.size;
+
+	if (node_count == 0)
+		return;
+
+	foreach (i, node_count)
+	{
+		TaskGraphNode *node = _task_graph_node_get(graph, i);
+		node->pending_predecessors = node->predecessor_count + node->wait_contexts.size;
+		node->remaining = 1;
+		node->context.completed = 0;
+		node->context.dispatched = 0;
+	}
+
+	graph->run_context = context;
+	graph->pending_nodes = node_count;
+
+	// Each node completes the run context once
+	if (context != NULL)
+		_task_context_dispatch(context, node_count);
+
+	_atomic_fence();
+
+	foreach (i, node_count)
+	{
+		TaskGraphNode *node = _task_graph_node_get(graph, i);
+
+		if (node->predecessor_count == 0 && node->wait_contexts.size == 0)
+			_task_graph_node_dispatch(node);
+	}
+
+	// The watched contexts dispatch the rest of the nodes, the array is not touched after the last watch
+	foreach (i, node_count)
+	{
+		TaskGraphNode *node = _task_graph_node_get(graph, i);
+		u32 count = node->wait_contexts.size;
+
+		foreach (j, count)
+			_task_context_watch((TaskContextWatcher *)array_get(&node->wait_contexts, j));
+	}
+}
+
+#endif
@@ -14,6 +14,7 @@
 #pragma comment(lib, "Shell32.lib")
 #pragma comment(lib, "Comdlg32.lib")
 #pragma comment(lib, "Xinput.lib")
+#pragma comment(lib, "Synchronization.lib")
 
 #define WRITE_BARRIER \
 	_WriteBarrier();  \
@@ -25,53 +26,11 @@
 
 #include "time.h"
 
-#include "Hosebase/platform.h"
+#include "platform_internal.h"
 #include "Hosebase/input.h"
 
 #include "Hosebase/graphics.h"
 
-#define TASK_QUEUE_SIZE 6000
-#define TASK_THREAD_MAX 64
-
-static b8 _task_initialize();
-static void _task_close();
-
-typedef struct
-{
-
-	HANDLE thread;
-	u32 id;
-
-} TaskThreadData;
-
-typedef struct
-{
-
-	TaskContext *context;
-	void *fn;
-	b8 user_data[TASK_DATA_SIZE];
-	u8 type;
-
-} TaskData;
-
-typedef struct
-{
-
-	TaskData tasks[TASK_QUEUE_SIZE];
-	volatile u32 task_count;
-	volatile u32 task_completed;
-	volatile u32 task_next;
-	volatile u32 reserved_threads;
-
-	HANDLE semaphore;
-
-	TaskThreadData thread_data[TASK_THREAD_MAX];
-	u32 thread_count;
-
-	b8 running;
-
-} TaskSystemData;
-
 HANDLE console_handle;
 
 typedef struct
@@ -99,7 +58,6 @@ typedef struct
 	LONG style_before_fullscreen;
 	v4_i32 pos_before_fullscreen;
 
-	TaskSystemData task_system;
 
 } WindowsData;
 
@@ -624,6 +582,7 @@ LRESULT CALLBACK window_proc(
 inline void configure_thread(HANDLE thread, const char *name, u64 affinity_mask, i32 priority)
 {
 	// Put the thread in a dedicated hardware core
+	if (affinity_mask)
 	{
 		DWORD_PTR mask = affinity_mask;
 		DWORD_PTR res = SetThreadAffinityMask(thread, mask);
@@ -661,7 +620,7 @@ b8 os_initialize(const PlatformInitializeDesc *desc)
 	windows->add_time = 0.0;
 	windows->last_time = 0.0;
 
-	configure_thread(GetCurrentThread(), "main_thread", 1ULL, THREAD_PRIORITY_HIGHEST);
+	configure_thread(GetCurrentThread(), "main_thread", 0, THREAD_PRIORITY_HIGHEST);
 
 	windows->hinstance = GetModuleHandle(NULL);
 	console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -713,7 +672,8 @@ b8 os_initialize(const PlatformInitializeDesc *desc)
 
 	windows->show_cursor = TRUE;
 
-	SV_CHECK(_task_initialize());
+	SV_CHECK(_task_initialize(desc));
+	SV_CHECK(_file_async_initialize());
 
 	// Register raw input
 	{
@@ -948,6 +908,7 @@ void os_close()
 	if (windows)
 	{
 		_task_close();
+		_file_async_close();
 
 		if (windows->handle)
 			DestroyWindow(windows->handle);
@@ -1399,6 +1360,63 @@ b8 file_date(FilepathType type, const char *filepath_, Date *create, Date *last_
 	return TRUE;
 }
 
+b8 file_map(FilepathType type, const char *filepath_, FileView *view)
+{
+	char filepath[MAX_PATH];
+	filepath_resolve(filepath, filepath_, type);
+
+	memory_zero(view, sizeof(FileView));
+
+	HANDLE file = CreateFile(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return FALSE;
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(file, &size) || size.QuadPart > (LONGLONG)u32_max)
+	{
+		CloseHandle(file);
+		return FALSE;
+	}
+
+	// Empty files can't be mapped
+	if (size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return TRUE;
+	}
+
+	HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if (mapping == NULL)
+	{
+		CloseHandle(file);
+		return FALSE;
+	}
+
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	// The view keeps the mapping and the file referenced
+	CloseHandle(mapping);
+	CloseHandle(file);
+
+	if (data == NULL)
+		return FALSE;
+
+	view->data = (const u8 *)data;
+	view->size = (u32)size.QuadPart;
+	return TRUE;
+}
+
+void file_unmap(FileView *view)
+{
+	if (view->data)
+		UnmapViewOfFile(view->data);
+
+	memory_zero(view, sizeof(FileView));
+}
+
 b8 file_remove(FilepathType type, const char *filepath_)
 {
 	char filepath[MAX_PATH];
@@ -1561,6 +1579,337 @@ void folder_iterator_close(FolderIterator *it)
 		FindClose(find);
 }
 
+//////////////////////////////// FILE WATCHER ////////////////////////////
+
+// The folders are watched instead of the files, the editors usually save replacing the file.
+// The changes are notified while the file is written, a reader can find it incomplete and wait for the next notification
+
+typedef struct
+{
+	HANDLE handle;
+	OVERLAPPED overlapped;
+	u32 file_count;
+	u64 hash;
+	DWORD buffer[4096]; // FILE_NOTIFY_INFORMATION entries, DWORD aligned
+} WatchFolder;
+
+typedef struct
+{
+	WatchFolder *folder;
+	FilepathType type;
+	char filepath[FILE_PATH_SIZE]; // As it was added
+	u32 name_offset;
+	b8 queued;
+} WatchFile;
+
+typedef struct
+{
+	HashMap(WatchFolder *) folders; // By resolved path, the folders are not moved while they are read
+	HashMap(WatchFile) files;		// By type and path
+	HashMap(u64) names;				// Folder and name of the events to the file hash
+	DynamicArray(u64) changes;		// File hashes
+} FileWatcherData;
+
+SV_INLINE u32 watch_name_offset(const char *filepath)
+{
+	u32 offset = 0;
+
+	for (u32 i = 0; filepath[i] != '\0'; ++i)
+	{
+		if (filepath[i] == '/' || filepath[i] == '\\')
+			offset = i + 1;
+	}
+
+	return offset;
+}
+
+// The paths don't distinguish the case or the separator
+SV_INLINE u64 watch_path_hash(const char *path, u64 seed)
+{
+	char buffer[FILE_PATH_SIZE];
+	u32 i = 0;
+
+	for (; path[i] != '\0' && i < FILE_PATH_SIZE - 1; ++i)
+	{
+		char c = path[i];
+
+		if (char_is_capital(c))
+			c += 'a' - 'A';
+		else if (c == '\\')
+			c = '/';
+
+		buffer[i] = c;
+	}
+
+	buffer[i] = '\0';
+
+	return hash_combine(hash_string(buffer), seed);
+}
+
+SV_INLINE u64 watch_file_hash(FilepathType type, const char *filepath)
+{
+	return hash_combine(hash_string(filepath), (u64)type + 1);
+}
+
+SV_INLINE u64 watch_name_hash(WatchFolder *folder, const char *name)
+{
+	return watch_path_hash(name, folder->hash);
+}
+
+static b8 watch_folder_read(WatchFolder *folder)
+{
+	memory_zero(&folder->overlapped, sizeof(OVERLAPPED));
+	return ReadDirectoryChangesW(folder->handle, folder->buffer, sizeof(folder->buffer), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, NULL, &folder->overlapped, NULL);
+}
+
+static void watch_folder_close(WatchFolder *folder)
+{
+	DWORD bytes;
+
+	// The buffer is written until the read is cancelled
+	if (CancelIo(folder->handle))
+		GetOverlappedResult(folder->handle, &folder->overlapped, &bytes, TRUE);
+
+	CloseHandle(folder->handle);
+	memory_free(folder);
+}
+
+static void watch_queue(FileWatcherData *data, u64 hash)
+{
+	WatchFile *file = (WatchFile *)hashmap_get(&data->files, hash);
+
+	// A save can notify more than once
+	if (file == NULL || file->queued)
+		return;
+
+	file->queued = TRUE;
+	array_push(&data->changes, hash);
+}
+
+FileWatcher file_watcher_create()
+{
+	FileWatcherData *data = memory_allocate(sizeof(FileWatcherData));
+	data->folders = hashmap_init(WatchFolder *);
+	data->files = hashmap_init(WatchFile);
+	data->names = hashmap_init(u64);
+	data->changes = array_init(u64, 2.f);
+
+	return (FileWatcher)data;
+}
+
+void file_watcher_destroy(FileWatcher watcher)
+{
+	FileWatcherData *data = (FileWatcherData *)watcher;
+
+	if (data == NULL)
+		return;
+
+	HashMapIterator it = {0};
+
+	while (hashmap_iterator_next(&data->folders, &it))
+		watch_folder_close(*(WatchFolder **)it.value);
+
+	hashmap_close(&data->folders);
+	hashmap_close(&data->files);
+	hashmap_close(&data->names);
+	array_close(&data->changes);
+
+	memory_free(data);
+}
+
+b8 file_watcher_add(FileWatcher watcher, FilepathType type, const char *filepath)
+{
+	FileWatcherData *data = (FileWatcherData *)watcher;
+
+	if (data == NULL)
+		return FALSE;
+
+	u64 hash = watch_file_hash(type, filepath);
+
+	if (hashmap_get(&data->files, hash))
+		return TRUE;
+
+	char folderpath[FILE_PATH_SIZE];
+	filepath_resolve(folderpath, filepath, type);
+
+	u32 offset = watch_name_offset(folderpath);
+
+	if (offset == 0)
+		string_copy(folderpath, ".", FILE_PATH_SIZE);
+	else
+		folderpath[offset] = '\0';
+
+	u64 folder_hash = watch_path_hash(folderpath, 1);
+
+	b8 created;
+	WatchFolder **folder_ptr = (WatchFolder **)hashmap_insert(&data->folders, folder_hash, &created);
+
+	if (created)
+	{
+		WatchFolder *folder = memory_allocate(sizeof(WatchFolder));
+		folder->hash = folder_hash;
+		folder->handle = CreateFile(folderpath, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+
+		if (folder->handle == INVALID_HANDLE_VALUE || !watch_folder_read(folder))
+		{
+			SV_LOG_ERROR("Can't watch the folder '%s': %u\n", folderpath, (u32)GetLastError());
+
+			if (folder->handle != INVALID_HANDLE_VALUE)
+				CloseHandle(folder->handle);
+
+			memory_free(folder);
+			hashmap_erase(&data->folders, folder_hash);
+			return FALSE;
+		}
+
+		*folder_ptr = folder;
+	}
+
+	WatchFolder *folder = *folder_ptr;
+	folder->file_count++;
+
+	WatchFile *file = (WatchFile *)hashmap_insert(&data->files, hash, NULL);
+	file->folder = folder;
+	file->type = type;
+	string_copy(file->filepath, filepath, FILE_PATH_SIZE);
+	file->name_offset = watch_name_offset(file->filepath);
+	file->queued = FALSE;
+
+	// The same file added with another path type replaces the previous one
+	u64 *name = (u64 *)hashmap_insert(&data->names, watch_name_hash(folder, file->filepath + file->name_offset), NULL);
+	*name = hash;
+
+	return TRUE;
+}
+
+void file_watcher_remove(FileWatcher watcher, FilepathType type, const char *filepath)
+{
+	FileWatcherData *data = (FileWatcherData *)watcher;
+
+	if (data == NULL)
+		return;
+
+	u64 hash = watch_file_hash(type, filepath);
+	WatchFile *file = (WatchFile *)hashmap_get(&data->files, hash);
+
+	if (file == NULL)
+		return;
+
+	WatchFolder *folder = file->folder;
+	u64 name_hash = watch_name_hash(folder, file->filepath + file->name_offset);
+
+	u64 *name = (u64 *)hashmap_get(&data->names, name_hash);
+
+	if (name && *name == hash)
+		hashmap_erase(&data->names, name_hash);
+
+	// The queued changes of the removed files are skipped
+	hashmap_erase(&data->files, hash);
+
+	if (--folder->file_count == 0)
+	{
+		hashmap_erase(&data->folders, folder->hash);
+		watch_folder_close(folder);
+	}
+}
+
+static void watch_read_events(FileWatcherData *data)
+{
+	HashMapIterator it = {0};
+
+	while (hashmap_iterator_next(&data->folders, &it))
+	{
+		WatchFolder *folder = *(WatchFolder **)it.value;
+		DWORD bytes;
+
+		if (!GetOverlappedResult(folder->handle, &folder->overlapped, &bytes, FALSE))
+		{
+			if (GetLastError() != ERROR_IO_INCOMPLETE)
+			{
+				SV_LOG_ERROR("Can't read the folder changes: %u\n", (u32)GetLastError());
+				watch_folder_read(folder);
+			}
+			continue;
+		}
+
+		// The buffer overflowed, any file of the folder may have changed
+		if (bytes == 0)
+		{
+			HashMapIterator file_it = {0};
+
+			while (hashmap_iterator_next(&data->files, &file_it))
+			{
+				if (((WatchFile *)file_it.value)->folder == folder)
+					watch_queue(data, file_it.hash);
+			}
+		}
+		else
+		{
+			u8 *entry = (u8 *)folder->buffer;
+
+			while (TRUE)
+			{
+				FILE_NOTIFY_INFORMATION *info = (FILE_NOTIFY_INFORMATION *)entry;
+
+				if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+				{
+					char name[FILE_PATH_SIZE];
+					i32 size = WideCharToMultiByte(CP_ACP, 0, info->FileName, (i32)(info->FileNameLength / sizeof(WCHAR)), name, FILE_PATH_SIZE - 1, NULL, NULL);
+
+					if (size > 0)
+					{
+						name[size] = '\0';
+
+						u64 *hash = (u64 *)hashmap_get(&data->names, watch_name_hash(folder, name));
+
+						if (hash)
+							watch_queue(data, *hash);
+					}
+				}
+
+				if (info->NextEntryOffset == 0)
+					break;
+
+				entry += info->NextEntryOffset;
+			}
+		}
+
+		watch_folder_read(folder);
+	}
+}
+
+b8 file_watcher_next(FileWatcher watcher, FilepathType *type, char *filepath)
+{
+	FileWatcherData *data = (FileWatcherData *)watcher;
+
+	if (data == NULL)
+		return FALSE;
+
+	if (data->changes.size == 0)
+		watch_read_events(data);
+
+	while (data->changes.size)
+	{
+		u64 hash = *(u64 *)array_last(&data->changes);
+		array_pop(&data->changes);
+
+		WatchFile *file = (WatchFile *)hashmap_get(&data->files, hash);
+
+		if (file == NULL || !file->queued)
+			continue;
+
+		file->queued = FALSE;
+
+		if (type)
+			*type = file->type;
+		string_copy(filepath, file->filepath, FILE_PATH_SIZE);
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
 //////////////////////////////// CLIPBOARD ////////////////////////////
 
 b8 clipboard_write_ansi(const char *text)
@@ -1642,9 +1991,35 @@ void mutex_unlock(Mutex mutex)
 	assert_title(mutex, "The mutex must be valid");
 }
 
+typedef struct
+{
+	ThreadMainFn fn;
+	void *data;
+} ThreadStart;
+
+static DWORD WINAPI thread_start(LPVOID arg)
+{
+	ThreadStart start = *(ThreadStart *)arg;
+	memory_free(arg);
+
+	i32 result = start.fn(start.data);
+
+	scratch_thread_close();
+	_memory_thread_close();
+	return (DWORD)result;
+}
+
 Thread thread_create(ThreadMainFn main, void *data)
 {
-	HANDLE handle = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)main, data, 0, NULL);
+	ThreadStart *start = memory_allocate(sizeof(ThreadStart));
+	start->fn = main;
+	start->data = data;
+
+	HANDLE handle = CreateThread(NULL, 0, thread_start, start, 0, NULL);
+
+	if (handle == NULL)
+		memory_free(start);
+
 	return (Thread)handle;
 }
 
@@ -1673,6 +2048,12 @@ void thread_sleep(u64 millis)
 	Sleep(millis);
 }
 
+u32 thread_stack_trace(void **frames, u32 max)
+{
+	// Skips this function
+	return (u32)RtlCaptureStackBackTrace(1, (DWORD)SV_MIN(max, 62), frames, NULL);
+}
+
 void thread_yield()
 {
 	SwitchToThread();
@@ -1714,248 +2095,135 @@ void thread_configure(Thread thread, const char *name, u64 affinity_mask, Thread
 	configure_thread((HANDLE)thread, name, affinity_mask, win_priority);
 }
 
-static DWORD WINAPI task_thread(void *arg);
+void os_futex_wait(volatile u32 *address, u32 value)
+{
+	WaitOnAddress(address, &value, sizeof(u32), INFINITE);
+}
 
-static b8 _task_initialize()
+void os_futex_wake(volatile u32 *address, b8 all)
 {
-	TaskSystemData *data = &windows->task_system;
-	data->running = TRUE;
+	if (all)
+		WakeByAddressAll((PVOID)address);
+	else
+		WakeByAddressSingle((PVOID)address);
+}
 
-	u32 thread_count;
+Thread os_thread_current()
+{
+	return (Thread)GetCurrentThread();
+}
 
-	// Compute preferred thread count
-	{
-		SYSTEM_INFO sysinfo;
-		GetSystemInfo(&sysinfo);
+u32 os_processor_count()
+{
+	// Counts every processor group, GetSystemInfo stops at 64
+	return SV_MAX(GetActiveProcessorCount(ALL_PROCESSOR_GROUPS), 1);
+}
 
-		thread_count = SV_MAX(sysinfo.dwNumberOfProcessors, 1);
-	}
+u32 os_cpu_topology(CpuInfo *cpus, u32 max)
+{
+	DWORD size = 0;
+	GetLogicalProcessorInformationEx(RelationAll, NULL, &size);
 
-	u64 affinity_offset = 1;
+	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+		return 0;
+
+	u8 *buffer = memory_allocate(size);
 
-	if (thread_count == 1)
+	if (!GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer, &size))
 	{
-		affinity_offset = 0;
+		memory_free(buffer);
+		return 0;
 	}
-	else
-		thread_count--;
-
-	thread_count = SV_MIN(thread_count, TASK_THREAD_MAX);
 
-	data->semaphore = CreateSemaphoreExA(NULL, 0, thread_count, NULL, 0, SEMAPHORE_ALL_ACCESS);
+	// The id is group * 64 + bit, the same layout of CpuMask
+	u32 count = 0;
+	u32 core = 0;
 
-	if (data->semaphore == NULL)
-		return FALSE;
+	PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info;
 
-	foreach (t, thread_count)
+	for (u8 *it = buffer; it < buffer + size; it += info->Size)
 	{
+		info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)it;
 
-		TaskThreadData *thread_data = data->thread_data + t;
-		thread_data->id = t;
-
-		thread_data->thread = CreateThread(NULL, 0, task_thread, thread_data, 0, NULL);
-
-		if (thread_data->thread == NULL)
-		{
-			SV_LOG_ERROR("Can't create task thread\n");
-			data->running = FALSE;
-			return FALSE;
-		}
+		if (info->Relationship != RelationProcessorCore)
+			continue;
 
-		// Config thread
+		foreach (g, info->Processor.GroupCount)
 		{
-			char name[200];
-			string_copy(name, "task_", 200);
-
-			char id_str[30];
-			string_from_u32(id_str, t);
+			GROUP_AFFINITY *group = info->Processor.GroupMask + g;
 
-			string_append(name, id_str, 200);
-
-			configure_thread(thread_data->thread, name, 1ull << (affinity_offset + (u64)t), THREAD_PRIORITY_HIGHEST);
+			foreach (bit, 64)
+			{
+				if ((group->Mask & (1ULL << (u64)bit)) && count < max)
+				{
+					CpuInfo *cpu = cpus + count++;
+					cpu->id = (u32)group->Group * 64 + bit;
+					cpu->core = core;
+					cpu->package = 0;
+					cpu->numa_node = 0;
+					cpu->performance = info->Processor.EfficiencyClass;
+				}
+			}
 		}
-	}
 
-	data->thread_count = thread_count;
-
-	return TRUE;
-}
-
-static void _task_close()
-{
-	task_join();
-
-	TaskSystemData *data = &windows->task_system;
-	data->running = FALSE;
-
-	HANDLE threads[TASK_THREAD_MAX];
-	foreach (i, data->thread_count)
-		threads[i] = data->thread_data[i].thread;
-
-	ReleaseSemaphore(data->semaphore, data->thread_count, 0);
-
-	if (WaitForMultipleObjectsEx(data->thread_count, threads, TRUE, 1000, FALSE) >= data->thread_count)
-	{
-		SV_LOG_ERROR("Can't close task threads properly\n");
+		core++;
 	}
 
-	CloseHandle(data->semaphore);
-}
+	u32 package = 0;
 
-inline b8 _task_thread_do_work()
-{
-	TaskSystemData *data = &windows->task_system;
-	b8 done = FALSE;
-
-	u32 task_next = data->task_next;
-
-	if (task_next < data->task_count)
+	for (u8 *it = buffer; it < buffer + size; it += info->Size)
 	{
-		u32 task_index = InterlockedCompareExchange((volatile LONG *)&data->task_next, task_next + 1, task_next);
-		READ_BARRIER;
+		info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)it;
 
-		if (task_index == task_next)
+		if (info->Relationship == RelationProcessorPackage)
 		{
-			TaskData task = data->tasks[task_index % TASK_QUEUE_SIZE];
-
-			// Task function
-			if (task.type == 1)
+			foreach (g, info->Processor.GroupCount)
 			{
-				assert(task.fn != NULL);
+				GROUP_AFFINITY *group = info->Processor.GroupMask + g;
 
-				TaskFn fn = task.fn;
-				fn(task.user_data);
-
-				InterlockedIncrement((volatile LONG *)&data->task_completed);
-				if (task.context != NULL)
-					InterlockedIncrement((volatile LONG *)&task.context->completed);
-				done = TRUE;
+				foreach (i, count)
+				{
+					if (cpus[i].id / 64 == group->Group && (group->Mask & (1ULL << (u64)(cpus[i].id % 64))))
+						cpus[i].package = package;
+				}
 			}
-			// Reserve thread
-			else if (task.type == 2)
-			{
-				InterlockedIncrement((volatile LONG *)&data->task_completed);
-				InterlockedIncrement((volatile LONG *)&data->reserved_threads);
-
-				ThreadMainFn fn = task.fn;
-				void *main_data = *(void **)task.user_data;
 
-				fn(main_data);
+			package++;
+		}
+		else if (info->Relationship == RelationNumaNode)
+		{
+			GROUP_AFFINITY *group = &info->NumaNode.GroupMask;
 
-				if (task.context != NULL)
-					InterlockedIncrement((volatile LONG *)&task.context->completed);
-				InterlockedDecrement((volatile LONG *)&data->reserved_threads);
+			foreach (i, count)
+			{
+				if (cpus[i].id / 64 == group->Group && (group->Mask & (1ULL << (u64)(cpus[i].id % 64))))
+					cpus[i].numa_node = info->NumaNode.NodeNumber;
 			}
 		}
 	}
 
-	return done;
-}
-
-static DWORD WINAPI task_thread(void *arg)
-{
-	TaskThreadData *thread = arg;
-	TaskSystemData *data = &windows->task_system;
-
-	while (data->running)
-	{
-		if (!_task_thread_do_work() && !task_running(NULL))
-		{
-			WaitForSingleObjectEx(data->semaphore, INFINITE, FALSE);
-		}
-	}
+	memory_free(buffer);
 
-	return 0;
+	return count;
 }
 
-static void _task_add_queue(TaskDesc desc, TaskContext *ctx)
+b8 thread_set_affinity(Thread thread, const CpuMask *mask)
 {
-	assert_title(desc.fn != NULL, "Null task function");
-	assert_title(desc.size <= TASK_DATA_SIZE, "The task data size is too large");
-
-	TaskSystemData *data = &windows->task_system;
-
-	TaskData *task = data->tasks + data->task_count % TASK_QUEUE_SIZE;
-	task->fn = desc.fn;
-	task->context = ctx;
-	if (desc.data)
-		memory_copy(task->user_data, desc.data, desc.size);
-	task->type = 1;
-
-	WRITE_BARRIER;
-	++data->task_count;
-
-	ReleaseSemaphore(data->semaphore, 1, 0);
-}
-
-void task_dispatch(TaskDesc *tasks, u32 task_count, TaskContext *context)
-{
-	TaskSystemData *data = &windows->task_system;
-
-	if (context)
-	{
-		context->dispatched += task_count;
-	}
-
-	foreach (i, task_count)
+	// A thread runs in a single processor group, the first one with processors in the mask
+	foreach (group, SV_CPU_MAX / 64)
 	{
-		_task_add_queue(tasks[i], context);
-	}
-}
-
-void task_reserve_thread(ThreadMainFn main_fn, void *main_data, TaskContext *context)
-{
-	TaskSystemData *data = &windows->task_system;
-
-	if (context != NULL)
-		context->dispatched++;
-
-	TaskData *task = data->tasks + data->task_count % TASK_QUEUE_SIZE;
-	task->fn = main_fn;
-	task->context = context;
-	memory_copy(task->user_data, &main_data, sizeof(void *));
-	task->type = 2;
-
-	WRITE_BARRIER;
-	volatile u32 task_index = data->task_count++;
-
-	ReleaseSemaphore(data->semaphore, 1, 0);
-
-	while (task_index >= data->task_next)
-		SwitchToThread();
-}
-
-void task_join()
-{
-	TaskSystemData *data = &windows->task_system;
-
-	task_wait(NULL);
+		if (mask->bits[group])
+		{
+			GROUP_AFFINITY affinity;
+			memory_zero(&affinity, sizeof(affinity));
+			affinity.Group = (WORD)group;
+			affinity.Mask = (KAFFINITY)mask->bits[group];
 
-	while (data->reserved_threads)
-	{
-		Sleep(10);
+			return SetThreadGroupAffinity((HANDLE)thread, &affinity, NULL) != 0;
+		}
 	}
-}
 
-void task_wait(TaskContext *context)
-{
-	TaskSystemData *data = &windows->task_system;
-
-	while (task_running(context))
-		_task_thread_do_work();
-}
-
-b8 task_running(TaskContext *context)
-{
-	if (context)
-	{
-		return context->completed < context->dispatched;
-	}
-	else
-	{
-		TaskSystemData *data = &windows->task_system;
-		return data->task_completed < data->task_count;
-	}
+	return FALSE;
 }
 
 u32 interlock_increment_u32(volatile u32 *n)
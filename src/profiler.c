@@ -12,6 +12,11 @@ typedef struct {
 
 	Mutex mutex;
 
+#if SV_PLATFORM_WINDOWS || SV_PLATFORM_LINUX
+	TaskWorkerStats* task_stats; // Values of the last capture
+	u32 task_stats_count;
+#endif
+
 } ProfilerData;
 
 static ProfilerData* profiler;
@@ -22,8 +27,12 @@ void _profiler_initialize()
 	profiler->mutex = mutex_create();
 }
 
+static void _profiler_capture_tasks();
+
 void _profiler_reset()
 {
+	_profiler_capture_tasks();
+
 	foreach(i, profiler->function_count)
 	{
 		ProfilerFunctionData* fn = profiler->functions + i;
@@ -43,6 +52,11 @@ void _profiler_close()
 
 		mutex_destroy(profiler->mutex);
 
+#if SV_PLATFORM_WINDOWS || SV_PLATFORM_LINUX
+		if (profiler->task_stats)
+			memory_free(profiler->task_stats);
+#endif
+
 		memory_free(profiler);
 	}
 }
@@ -82,7 +96,7 @@ inline ProfilerFunctionData* find_function(u64 hash)
 	return NULL;
 }
 
-void _profiler_save(const char* name, struct _ProfilerChrono res, b8 is_function)
+static void _profiler_add(const char* name, f64 time, u32 calls, b8 is_function)
 {
 	u64 hash = hash_string(name);
 
@@ -95,14 +109,69 @@ void _profiler_save(const char* name, struct _ProfilerChrono res, b8 is_function
 	
 	ProfilerFunctionFrame* frame = fn->frames + (fn->current_frame % PROFILER_FUNCTION_CACHE);
 
-	f64 ellapsed = res.end - res.begin;
-
-	frame->total_time += ellapsed;
-	frame->calls++;
+	frame->total_time += time;
+	frame->calls += calls;
 
 	mutex_unlock(profiler->mutex);
 }
 
+void _profiler_save(const char* name, struct _ProfilerChrono res, b8 is_function)
+{
+	_profiler_add(name, res.end - res.begin, 1, is_function);
+}
+
+#if SV_PLATFORM_WINDOWS || SV_PLATFORM_LINUX
+
+static void _profiler_task_entry(u32 worker, const char* counter, f64 time, u64 calls)
+{
+	char name[PROFILER_FN_NAME_SIZE];
+	char id_str[30];
+
+	string_copy(name, "task_", PROFILER_FN_NAME_SIZE);
+	string_from_u32(id_str, worker);
+	string_append(name, id_str, PROFILER_FN_NAME_SIZE);
+	string_append(name, " ", PROFILER_FN_NAME_SIZE);
+	string_append(name, counter, PROFILER_FN_NAME_SIZE);
+
+	_profiler_add(name, time, (u32)calls, FALSE);
+}
+
+// Saves the task worker counters of the ending frame, the calls are executed tasks or successful steals
+static void _profiler_capture_tasks()
+{
+	u32 count = task_worker_count();
+
+	if (profiler->task_stats_count != count) {
+
+		if (profiler->task_stats)
+			memory_free(profiler->task_stats);
+
+		profiler->task_stats = memory_allocate(sizeof(TaskWorkerStats) * count);
+		profiler->task_stats_count = count;
+	}
+
+	foreach(i, count) {
+
+		TaskWorkerStats stats = task_worker_stats(i);
+		TaskWorkerStats* last = profiler->task_stats + i;
+
+		u64 executed = stats.executed - last->executed;
+
+		_profiler_task_entry(i, "busy", stats.busy_time - last->busy_time, executed);
+		_profiler_task_entry(i, "idle", stats.idle_time - last->idle_time, 0);
+		_profiler_task_entry(i, "wait", stats.wait_time - last->wait_time, executed);
+		_profiler_task_entry(i, "steals", 0.0, stats.steal_successes - last->steal_successes);
+
+		*last = stats;
+	}
+}
+
+#else
+
+static void _profiler_capture_tasks() {}
+
+#endif
+
 void profiler_lock()
 {
 	mutex_lock(profiler->mutex);
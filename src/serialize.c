@@ -5,8 +5,8 @@
 #include "Hosebase/platform.h"
 
 #define STBI_ASSERT(x) assert(x)
-#define STBI_MALLOC(size) memory_allocate(size)
-#define STBI_REALLOC(ptr, size) realloc(ptr, size)
+#define STBI_MALLOC(size) memory_allocate_uninit(size)
+#define STBI_REALLOC(ptr, size) memory_reallocate(ptr, size)
 #define STBI_FREE(ptr) memory_free(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 
@@ -14,14 +14,13 @@
 
 b8 load_image(FilepathType type, const char* filepath, void** pdata, u32* width, u32* height)
 {
-	u8* bin;
-	u32 bin_size;
-	if (!file_read_binary(type, filepath, &bin, &bin_size))
+	FileView file;
+	if (!file_map(type, filepath, &file))
 		return FALSE;
 	
 	int w = 0, h = 0, bits = 0;
-	void* data = stbi_load_from_memory(bin, bin_size, &w, &h, &bits, 4);
-	memory_free(bin);
+	void* data = stbi_load_from_memory(file.data, file.size, &w, &h, &bits, 4);
+	file_unmap(&file);
 
 	* pdata = NULL;
 	*width = w;
@@ -72,24 +71,14 @@ b8 bin_write(u64 hash, const void* data, u32 size)
 
 inline b8 xml_string_equals(const char* str0, const char* str1)
 {
-	while (*str0 != '\0' && *str1 != '\0') {
+	// The names end with the tag or the attributes
+	u32 size0 = string_split(str0, "> /", 3);
+	u32 size1 = string_split(str1, "> /", 3);
 
-		if (*str0 == '>' || *str0 == '/' || *str0 == ' ') {
-			str0 = " ";
-		}
-		if (*str1 == '>' || *str1 == '/' || *str1 == ' ') {
-			str1 = " ";
-		}
-
-		if (*str0 != *str1) {
-			return FALSE;
-		}
-
-		++str0;
-		++str1;
-	}
+	if (size0 != size1 || memcmp(str0, str1, size0) != 0)
+		return FALSE;
 
-	return *str0 == *str1;
+	return (str0[size0] == '\0') == (str1[size1] == '\0');
 }
 
 inline const char* xml_exit_tag(const char* c)
@@ -138,9 +127,14 @@ inline const char* xml_find_end(const char* begin)
 	// Find close tag
 	{
 		while (1) {
-			while (*c != '\0' && *c != '<') {
+			while (1) {
+
+				c = string_find_any(c, "</", 2);
 
-				if (*c == '/' && *(c + 1) == '>') {
+				if (*c != '/')
+					break;
+
+				if (*(c + 1) == '>') {
 					level--;
 					++c;
 				}
@@ -182,25 +176,8 @@ inline const char* xml_find_end(const char* begin)
 
 inline b8 xml_string_equals_to_normal(const char* xml_str, const char* normal)
 {
-	while (*xml_str != '\0' && *normal != '\0') {
-
-		if (*xml_str == '/' || *xml_str == '>' || *xml_str == ' ' || *xml_str == '=') {
-			xml_str = "";
-		}
-
-		if (*xml_str != *normal) {
-			return FALSE;
-		}
-
-		++xml_str;
-		++normal;
-	}
-
-	if (*xml_str == '/' || *xml_str == '>' || *xml_str == ' ' || *xml_str == '=') {
-		xml_str = "";
-	}
-
-	return *xml_str == *normal;
+	u32 size = string_split(xml_str, "/> =", 4);
+	return strncmp(xml_str, normal, size) == 0 && normal[size] == '\0';
 }
 
 XMLElement xml_begin(const char* data, u32 size)
@@ -247,7 +224,7 @@ XMLElement xml_begin(const char* data, u32 size)
 			}
 		}
 		else if (*c == '\n' || *c == ' ' || *c == '\r' || *c == '\t') {
-			++c;
+			c = string_skip_whitespace(c);
 		}
 		else {
 			e.corrupted = TRUE;
@@ -427,9 +404,7 @@ b8 xml_get_attribute(XMLElement* e, char* buffer, u32 buffer_size, const char* a
 
 		if (*c == ' ' || *c == '\n' || *c == '\t') {
 
-			while (*c == ' ' || *c == '\n' || *c == '\t') {
-				++c;
-			}
+			c = string_skip_whitespace(c);
 
 			if (*c == '\0' || *c == '>' || *c == '/') {
 				return FALSE;
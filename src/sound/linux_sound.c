@@ -0,0 +1,31 @@
+#if SV_PLATFORM_LINUX
+
+#include "sound_internal.h"
+
+// The linux platform is headless, there is no audio device to write to
+
+b8 sound_platform_initialize(u32 samples_per_second)
+{
+	SV_LOG_WARNING("The linux platform runs without audio device\n");
+	return FALSE;
+}
+
+void sound_configure_thread(Thread thread)
+{
+}
+
+void sound_platform_close()
+{
+}
+
+void sound_compute_sample_range(u32 sample_index, u32* sample_count, u32* offset)
+{
+	*sample_count = 0;
+	*offset = 0;
+}
+
+void sound_fill_buffer(f32* samples, u32 sample_count, u32 offset)
+{
+}
+
+#endif
@@ -4,7 +4,6 @@
 // TODO: Adjust
 
 #define AUDIO_SOURCE_MAX 10000
-#define AUDIO_SOURCE_TABLE_SIZE 500
 
 #define AudioSourceFlag_Valid SV_BIT(0)
 #define AudioSourceFlag_Stopped SV_BIT(1)
@@ -13,17 +12,14 @@
 
 #define MUSIC_MAX 100
 
-typedef struct AudioSource AudioSource;
-
-struct AudioSource
+typedef struct
 {
     AudioProperties props;
     Asset audio_asset;
     u32 begin_sample_index;
     u32 flags;
     u64 hash;
-    AudioSource *next;
-};
+} AudioSource;
 
 typedef struct
 {
@@ -55,12 +51,9 @@ typedef struct
     u32 sample_index;
     f32 *samples;
 
-    AudioSource sources[AUDIO_SOURCE_MAX];
-    u32 source_count;
-
-    AudioSource *free_sources;
-
-    AudioSource *source_table[AUDIO_SOURCE_TABLE_SIZE];
+    // Only the playing sources are stored, the mixer iterates them packed
+    SlotMap(AudioSource) sources;
+    HashMap(SlotHandle) source_table;
     Mutex mutex_source;
 
     AudioInstance instances[AUDIO_INSTANCE_MAX];
@@ -184,15 +177,15 @@ typedef struct
 b8 audio_load(Audio *audio, const char *filepath)
 {
     Deserializer s;
-    u8 *data;
-    u32 size;
+    FileView file;
 
     b8 res = TRUE;
 
-    if (file_read_binary(FilepathType_Asset, filepath, &data, &size))
+    if (file_map(FilepathType_Asset, filepath, &file))
     {
+        u32 size = file.size;
 
-        deserializer_begin_buffer(&s, data, size);
+        deserializer_begin_buffer(&s, (void *)file.data, size);
 
         WaveHeader header;
         deserializer_read(&s, &header, sizeof(WaveHeader));
@@ -315,7 +308,7 @@ b8 audio_load(Audio *audio, const char *filepath)
 
     free_data:
         deserializer_end_file(&s);
-        memory_free(data);
+        file_unmap(&file);
     }
     else
         res = FALSE;
@@ -419,13 +412,15 @@ void audio_stop()
     {
         audio_source_lock();
 
-        foreach (source_index, sound->source_count)
+        foreach (source_index, slotmap_size(&sound->sources))
         {
-
-            AudioSource *src = sound->sources + source_index;
-            free_audio_source(src->hash);
+            AudioSource *src = slotmap_value(&sound->sources, source_index);
+            asset_decrement(src->audio_asset);
         }
 
+        slotmap_reset(&sound->sources);
+        hashmap_reset(&sound->source_table);
+
         audio_source_unlock();
     }
 
@@ -444,119 +439,58 @@ void audio_stop()
 
 ///////////////////////////////// AUDIO SOURCE //////////////////////////////////////////
 
-// Add a valid asset to create a new one if doesn't exists
+// Add a valid asset to create a new one if doesn't exists. The id 0 is reserved
 inline AudioSource *get_audio_source(u64 hash, Asset audio_asset)
 {
-    AudioSource *src = NULL;
-    AudioSource *parent = NULL;
+    SlotHandle *handle = hashmap_get(&sound->source_table, hash);
 
-    AudioSource **source = sound->source_table + hash % AUDIO_SOURCE_TABLE_SIZE;
-
-    if (*source)
-    {
+    if (handle != NULL)
+        return slotmap_get(&sound->sources, *handle);
 
-        src = *source;
-
-        while (src->hash != hash)
-        {
-
-            parent = src;
-            src = src->next;
-            if (src == NULL)
-            {
-                break;
-            }
-        }
-    }
+    if (hash == 0 || audio_asset == 0)
+        return NULL;
 
-    if (src == NULL && audio_asset)
+    if (slotmap_size(&sound->sources) >= AUDIO_SOURCE_MAX)
     {
+        SV_LOG_WARNING("Audio source playing limit is '%u'\n", AUDIO_SOURCE_MAX);
+        return NULL;
+    }
 
-        // Create a new one
-        {
-            if (sound->free_sources)
-            {
-                src = sound->free_sources;
-                sound->free_sources = src->next;
-            }
-
-            if (src == NULL)
-            {
-                if (sound->source_count >= AUDIO_SOURCE_MAX)
-                {
-                    SV_LOG_WARNING("Audio source playing limit is '%u'\n", AUDIO_SOURCE_MAX);
-                    return NULL;
-                }
+    SlotHandle new_handle;
+    AudioSource *src = slotmap_insert(&sound->sources, &new_handle);
 
-                src = sound->sources + sound->source_count++;
-            }
+    if (src == NULL)
+        return NULL;
 
-            src->flags = AudioSourceFlag_Valid;
-            src->hash = hash;
-            src->next = NULL;
-            src->audio_asset = audio_asset;
+    handle = hashmap_insert(&sound->source_table, hash, NULL);
+    *handle = new_handle;
 
-            asset_increment(src->audio_asset);
-        }
+    src->flags = AudioSourceFlag_Valid;
+    src->hash = hash;
+    src->audio_asset = audio_asset;
 
-        if (parent != NULL)
-        {
-
-            parent->next = src;
-        }
-        else
-            *source = src;
-    }
+    asset_increment(src->audio_asset);
 
     return src;
 }
 
 inline void free_audio_source(u64 hash)
 {
-    AudioSource *src = NULL;
-    AudioSource *parent = NULL;
-
-    AudioSource **source = sound->source_table + hash % AUDIO_SOURCE_TABLE_SIZE;
-
-    if (*source)
-    {
-
-        src = *source;
-
-        while (src->hash != hash)
-        {
-
-            parent = src;
-            src = src->next;
-            if (src == NULL)
-            {
-                break;
-            }
-        }
-
-        if (src != NULL)
-        {
+    SlotHandle *handle = hashmap_get(&sound->source_table, hash);
 
-            if (parent != NULL)
-            {
-                parent->next = src->next;
-            }
-            else
-            {
-                *source = src->next;
-            }
-
-            // TODO: Erase from free link list as much as possible
-
-            asset_decrement(src->audio_asset);
+    if (handle == NULL)
+        return;
 
-            memory_zero(src, sizeof(AudioSource));
+    SlotHandle source_handle = *handle;
+    AudioSource *src = slotmap_get(&sound->sources, source_handle);
 
-            // Add to link list
-            src->next = sound->free_sources;
-            sound->free_sources = src;
-        }
+    if (src != NULL)
+    {
+        asset_decrement(src->audio_asset);
+        slotmap_remove(&sound->sources, source_handle);
     }
+
+    hashmap_erase(&sound->source_table, hash);
 }
 
 void audio_source_lock()
@@ -964,9 +898,10 @@ static i32 thread_main(void *_data)
             {
                 audio_source_lock();
 
-                foreach (source_index, sound->source_count)
+                // Backwards, a removed source is replaced by the last one
+                for (u32 source_index = slotmap_size(&sound->sources); source_index-- > 0;)
                 {
-                    AudioSource *src = sound->sources + source_index;
+                    AudioSource *src = slotmap_value(&sound->sources, source_index);
 
                     if (!write_audio(src->begin_sample_index, src->audio_asset, &src->props, &listener, samples_to_write))
                     {
@@ -1033,8 +968,16 @@ b8 sound_initialize(u32 samples_per_second)
     sound = memory_allocate(sizeof(SoundSystemData));
 
     sound->samples_per_second = samples_per_second;
+    sound->sources = slotmap_init(AudioSource);
+    sound->source_table = hashmap_init(SlotHandle);
 
-    SV_CHECK(sound_platform_initialize(samples_per_second));
+    if (!sound_platform_initialize(samples_per_second))
+    {
+        // Nothing to close without audio device
+        memory_free(sound);
+        sound = NULL;
+        return FALSE;
+    }
 
     // Register audio asset
     {
@@ -1096,6 +1039,9 @@ void sound_close()
 
         sound_platform_close();
 
+        slotmap_close(&sound->sources);
+        hashmap_close(&sound->source_table);
+
         memory_free(sound->samples);
         memory_free(sound);
     }
@@ -1,5 +1,8 @@
 #include "Hosebase/text_processing.h"
 
+#if SV_GRAPHICS
+
+
 #include "Hosebase/memory_manager.h"
 #include "Hosebase/input.h"
 
@@ -846,3 +849,5 @@ void text_process(const TextProcessDesc* desc)
 	ctx->cursor0 = c0;
 	ctx->cursor1 = c1;
 }
+
+#endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+// Task graph nodes that depend on external contexts. Built by hand like the linux apps (doc/build_linux.txt), from the folder that contains the Hosebase folder:
+//
+//   gcc -O2 -fgnu89-inline -DSV_PLATFORM_LINUX=1 -DSV_SLOW=1 -I. -IHosebase/src/platform Hosebase/tests/task_graph.c Hosebase/src/platform/*.c Hosebase/src/*.c Hosebase/src/sound/*.c -lpthread -ldl -lm -o task_graph
+//
+// Exits with 1 if a node starts before the context it depends on is drained
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Hosebase/hosebase.h"
+
+#define TEST_PARENTS 32
+#define TEST_ITERATIONS 200
+
+static TaskContext external;
+static volatile u32 children_done;
+static volatile u32 nodes_done;
+static u32 failures;
+
+static void child_task(void *arg)
+{
+	for (volatile u32 i = 0; i < 20000; ++i)
+		;
+
+	interlock_increment_u32(&children_done);
+}
+
+// Dispatches into its own context while running
+static void parent_task(void *arg)
+{
+	TaskDesc desc = {child_task, NULL, 0};
+	task_dispatch(&desc, 1, &external);
+}
+
+static void node_task(void *arg)
+{
+	if (children_done != TEST_PARENTS)
+		interlock_increment_u32((volatile u32 *)&failures);
+
+	interlock_increment_u32(&nodes_done);
+}
+
+static void test_self_dispatch()
+{
+	TaskGraph graph = task_graph_create();
+	TaskNode node = task_graph_add(graph, node_task, NULL, 0);
+	task_graph_depend_context(graph, node, &external);
+
+	foreach (iteration, TEST_ITERATIONS)
+	{
+		memory_zero(&external, sizeof(external));
+		children_done = 0;
+		nodes_done = 0;
+
+		TaskDesc tasks[TEST_PARENTS];
+
+		foreach (i, TEST_PARENTS)
+		{
+			tasks[i].fn = parent_task;
+			tasks[i].data = NULL;
+			tasks[i].size = 0;
+		}
+
+		task_dispatch(tasks, TEST_PARENTS, &external);
+
+		TaskContext run = {0};
+		task_graph_run(graph, &run);
+		task_wait(&run);
+		task_wait(&external);
+
+		if (nodes_done != 1)
+			failures++;
+	}
+
+	task_graph_destroy(graph);
+}
+
+// A context without tasks is drained, the node starts with the graph
+static void test_drained_context()
+{
+	TaskContext drained = {0};
+
+	TaskGraph graph = task_graph_create();
+	TaskNode node = task_graph_add(graph, node_task, NULL, 0);
+	task_graph_depend_context(graph, node, &drained);
+
+	children_done = TEST_PARENTS;
+	nodes_done = 0;
+
+	TaskContext run = {0};
+	task_graph_run(graph, &run);
+	task_wait(&run);
+
+	if (nodes_done != 1)
+		failures++;
+
+	task_graph_destroy(graph);
+}
+
+b8 initialize()
+{
+	HosebaseInitializeDesc desc;
+	memory_zero(&desc, sizeof(desc));
+
+	// More workers than processors, the tasks get preempted between the dispatch and the completion
+	desc.os.task.worker_count = 7;
+
+	return hosebase_initialize(&desc);
+}
+
+void update()
+{
+	test_self_dispatch();
+	test_drained_context();
+
+	printf("task graph: %u failures\n", failures);
+
+	if (failures)
+		exit(1);
+
+	raise(SIGTERM);
+}
+
+void close()
+{
+	hosebase_close();
+}
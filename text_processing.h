@@ -1,5 +1,9 @@
 #pragma once
 
+#include "Hosebase/defines.h"
+
+#if SV_GRAPHICS
+
 #include "Hosebase/graphics.h"
 #include "Hosebase/font.h"
 #include "Hosebase/math.h"
@@ -96,4 +100,6 @@ typedef struct {
 	u64* out_flags;
 } TextProcessDesc;
 
-void text_process(const TextProcessDesc* desc);
\ No newline at end of file
+void text_process(const TextProcessDesc* desc);
+
+#endif
\ No newline at end of file